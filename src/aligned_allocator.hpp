@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace solver {
+
+inline constexpr std::size_t cache_line_size = 64;
+inline constexpr std::size_t huge_page_size = std::size_t{ 2 } << 20U;
+
+/**
+ * A standard allocator that aligns every block to 'alignment' bytes, and rounds its size to a multiple of it.
+ * With huge-page alignment, Linux is also advised to back the block with transparent huge pages, so that
+ * large hot arrays take fewer TLB entries.
+ */
+template<typename T, std::size_t alignment = cache_line_size> class aligned_allocator
+{
+    static_assert(alignment >= alignof(T) && (alignment & (alignment - 1)) == 0, "alignment must be a power of 2");
+
+  public:
+    using value_type = T;
+    template<typename U> struct rebind
+    {
+        using other = aligned_allocator<U, alignment>;
+    };
+
+    aligned_allocator() = default;
+    template<typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    aligned_allocator(const aligned_allocator<U, alignment> &) noexcept
+    {}
+
+    T *allocate(std::size_t count)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / sizeof(T) - alignment) {
+            throw std::bad_array_new_length();
+        }
+        const std::size_t bytes = (count * sizeof(T) + alignment - 1) / alignment * alignment;
+        void *block = std::aligned_alloc(alignment, bytes);
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if constexpr (alignment >= huge_page_size) {
+            // Only a hint, the allocation is valid whether or not the kernel honors it.
+            madvise(block, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<T *>(block);
+    }
+    void deallocate(T *block, std::size_t) noexcept { std::free(block); }// NOLINT(cppcoreguidelines-no-malloc)
+
+    template<typename U> friend bool operator==(const aligned_allocator &, const aligned_allocator<U, alignment> &)
+    {
+        return true;
+    }
+};
+
+}// namespace solver
@@ -0,0 +1,78 @@
+#pragma once
+#include "constraint.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace solver {
+
+/**
+ * Requires all its parameters to take pairwise distinct values.
+ * Propagation is forward-checking: the value of every assigned parameter is removed from the domains
+ * of all the other parameters, cascading whenever such a removal assigns another parameter.
+ */
+template<constraint_state state_template_t>
+requires(!bool_domain<state_template_t>) class all_different
+{
+  public:
+    using state_t = state_template_t;
+    using parameter_t = typename state_t::parameter_t;
+    using domain_type = typename state_t::domain_type;
+    using value_type = typename domain_type::value_type;
+
+    explicit all_different(std::vector<parameter_t> parameters) : m_parameters(std::move(parameters)) {}
+
+    bool is_satisfied(const state_t &state) const
+    {
+        std::vector<value_type> values;
+        values.reserve(m_parameters.size());
+        for (const parameter_t &param : m_parameters) { values.push_back(state.get_value(param)); }
+        std::sort(values.begin(), values.end());
+        return std::adjacent_find(values.begin(), values.end()) == values.end();
+    }
+
+    propagation_result_t propagate(state_t &state, unsigned trigger_param)
+    {
+        if (trigger_param >= num_parameters()) {
+            throw std::out_of_range("trigger param is too big");
+        }
+        for (unsigned i = 0; i != num_parameters(); ++i) {
+            if (state.get_domain(m_parameters[i]).size() == 1 && !remove_from_others(state, i)) {
+                return propagation_result_t::UNSAT;
+            }
+        }
+        const bool all_assigned = std::all_of(m_parameters.begin(),
+            m_parameters.end(),
+            [&state](const parameter_t &param) { return state.get_domain(param).size() == 1; });
+        return all_assigned ? propagation_result_t::SAT : propagation_result_t::CONSISTENT;
+    }
+
+    parameter_t get_parameter(unsigned index) const { return m_parameters[index]; }
+    unsigned num_parameters() const { return static_cast<unsigned>(m_parameters.size()); }
+
+  private:
+    bool remove_from_others(state_t &state, unsigned assigned_index) const
+    {
+        const value_type value = *state.get_domain(m_parameters[assigned_index]).begin();
+        for (unsigned i = 0; i != num_parameters(); ++i) {
+            if (i == assigned_index || state.get_domain(m_parameters[i]).count(value) == 0) {
+                continue;
+            }
+            domain_type domain = state.get_domain(m_parameters[i]);
+            domain.erase(value);
+            const auto remaining = domain.size();
+            if (remaining == 0) {
+                return false;
+            }
+            state.set_domain(m_parameters[i], domain);
+            if (remaining == 1 && i < assigned_index && !remove_from_others(state, i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<parameter_t> m_parameters;
+};
+
+}// namespace solver
@@ -0,0 +1,168 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace solver {
+
+/**
+ * A domain of small non-negative integers [0, max_values), stored as a fixed-size bitset.
+ * It mimics the subset of the std::set interface that the solver uses, but never allocates,
+ * and its set operations are word-wise loops the compiler can vectorize.
+ */
+template<unsigned max_values> class bitset_domain
+{
+    static_assert(max_values > 0 && max_values % 64 == 0, "bitset_domain size must be a positive multiple of 64");
+    using word_t = std::uint64_t;
+    static constexpr unsigned word_bits = 64;
+    static constexpr unsigned num_words = max_values / word_bits;
+
+  public:
+    using value_type = int;
+    using size_type = std::size_t;
+
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = bitset_domain::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() = default;
+        value_type operator*() const { return static_cast<value_type>(m_index); }
+        const_iterator &operator++()
+        {
+            m_index = m_domain->find_from(m_index + 1);
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator ret = *this;
+            ++*this;
+            return ret;
+        }
+        bool operator==(const const_iterator &other) const { return m_index == other.m_index; }
+
+      private:
+        friend class bitset_domain;
+        const_iterator(const bitset_domain *domain, unsigned index) : m_domain(domain), m_index(index) {}
+        const bitset_domain *m_domain = nullptr;
+        unsigned m_index = max_values;
+    };
+    using iterator = const_iterator;
+
+    constexpr bitset_domain() = default;
+    constexpr bitset_domain(std::initializer_list<value_type> values)
+    {
+        for (value_type value : values) { insert(value); }
+    }
+
+    /// Returns the domain {min_value, ..., max_value}.
+    static constexpr bitset_domain range(value_type min_value, value_type max_value)
+    {
+        bitset_domain ret;
+        for (value_type value = min_value; value <= max_value; ++value) { ret.insert(value); }
+        return ret;
+    }
+
+    static constexpr unsigned capacity() { return max_values; }
+
+    const_iterator begin() const { return { this, find_from(0) }; }
+    const_iterator end() const { return { this, max_values }; }
+
+    constexpr size_type size() const
+    {
+        size_type ret = 0;
+        for (word_t word : m_words) { ret += static_cast<size_type>(std::popcount(word)); }
+        return ret;
+    }
+    constexpr bool empty() const
+    {
+        return std::all_of(m_words.begin(), m_words.end(), [](word_t word) { return word == 0; });
+    }
+    constexpr size_type count(value_type value) const
+    {
+        return in_range(value) && (m_words[word_of(value)] & bit_of(value)) != 0 ? 1 : 0;
+    }
+    constexpr void insert(value_type value)
+    {
+        assert(in_range(value));
+        m_words[word_of(value)] |= bit_of(value);
+    }
+    constexpr size_type erase(value_type value)
+    {
+        if (count(value) == 0) {
+            return 0;
+        }
+        m_words[word_of(value)] &= ~bit_of(value);
+        return 1;
+    }
+    constexpr void clear() { m_words.fill(0); }
+
+    /// Smallest value in the domain, the domain must not be empty.
+    constexpr value_type min() const
+    {
+        assert(!empty());
+        return static_cast<value_type>(find_from(0));
+    }
+    /// Largest value in the domain, the domain must not be empty.
+    constexpr value_type max() const
+    {
+        assert(!empty());
+        for (unsigned word = num_words; word-- != 0;) {
+            if (m_words[word] != 0) {
+                return static_cast<value_type>(word * word_bits + word_bits - 1
+                                               - static_cast<unsigned>(std::countl_zero(m_words[word])));
+            }
+        }
+        return 0;
+    }
+
+    constexpr bitset_domain &operator&=(const bitset_domain &other)
+    {
+        for (unsigned word = 0; word != num_words; ++word) { m_words[word] &= other.m_words[word]; }
+        return *this;
+    }
+    constexpr bitset_domain &operator|=(const bitset_domain &other)
+    {
+        for (unsigned word = 0; word != num_words; ++word) { m_words[word] |= other.m_words[word]; }
+        return *this;
+    }
+    friend constexpr bitset_domain operator&(bitset_domain lhs, const bitset_domain &rhs) { return lhs &= rhs; }
+    friend constexpr bitset_domain operator|(bitset_domain lhs, const bitset_domain &rhs) { return lhs |= rhs; }
+    friend constexpr bool operator==(const bitset_domain &, const bitset_domain &) = default;
+
+  private:
+    static constexpr bool in_range(value_type value) { return value >= 0 && std::cmp_less(value, max_values); }
+    static constexpr unsigned word_of(value_type value) { return static_cast<unsigned>(value) / word_bits; }
+    static constexpr word_t bit_of(value_type value)
+    {
+        return word_t{ 1 } << (static_cast<unsigned>(value) % word_bits);
+    }
+
+    constexpr unsigned find_from(unsigned index) const
+    {
+        for (unsigned word = index / word_bits; word < num_words; ++word) {
+            word_t bits = m_words[word];
+            if (word == index / word_bits) {
+                bits &= ~word_t{ 0 } << (index % word_bits);
+            }
+            if (bits != 0) {
+                return word * word_bits + static_cast<unsigned>(std::countr_zero(bits));
+            }
+        }
+        return max_values;
+    }
+
+    alignas(sizeof(word_t) * num_words) std::array<word_t, num_words> m_words{};
+};
+
+}// namespace solver
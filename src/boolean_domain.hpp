@@ -0,0 +1,98 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+namespace solver {
+
+/**
+ * A subset of {false, true}, stored as a two-bit mask where bit 0 stands for false and bit 1 for true.
+ * It has the std::set<bool> interface that the solver uses, without the allocations.
+ */
+class boolean_domain
+{
+  public:
+    using value_type = bool;
+    using size_type = std::size_t;
+    using mask_t = std::uint8_t;
+
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = bool;
+
+        const_iterator() = default;
+        bool operator*() const { return m_bit != 0; }
+        const_iterator &operator++()
+        {
+            m_bit = (m_bit == 0 && (m_mask & true_bit) != 0) ? 1 : 2;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator ret = *this;
+            ++*this;
+            return ret;
+        }
+        bool operator==(const const_iterator &other) const { return m_bit == other.m_bit; }
+
+      private:
+        friend class boolean_domain;
+        const_iterator(mask_t mask, unsigned bit) : m_mask(mask), m_bit(bit) {}
+        mask_t m_mask = 0;
+        unsigned m_bit = 2;
+    };
+    using iterator = const_iterator;
+
+    constexpr boolean_domain() = default;
+    constexpr boolean_domain(std::initializer_list<bool> values)
+    {
+        for (bool value : values) { insert(value); }
+    }
+    static constexpr boolean_domain from_mask(mask_t mask)
+    {
+        boolean_domain ret;
+        ret.m_mask = mask;
+        return ret;
+    }
+    constexpr mask_t mask() const { return m_mask; }
+
+    const_iterator begin() const
+    {
+        if ((m_mask & false_bit) != 0) {
+            return { m_mask, 0 };
+        }
+        return { m_mask, (m_mask & true_bit) != 0 ? 1U : 2U };
+    }
+    const_iterator end() const { return { m_mask, 2 }; }
+
+    constexpr size_type size() const { return static_cast<size_type>(std::popcount(m_mask)); }
+    constexpr bool empty() const { return m_mask == 0; }
+    constexpr size_type count(bool value) const { return (m_mask & bit_of(value)) != 0 ? 1 : 0; }
+    constexpr void insert(bool value) { m_mask = static_cast<mask_t>(m_mask | bit_of(value)); }
+    constexpr size_type erase(bool value)
+    {
+        const size_type ret = count(value);
+        m_mask = static_cast<mask_t>(m_mask & ~bit_of(value));
+        return ret;
+    }
+    constexpr void clear() { m_mask = 0; }
+    friend constexpr bool operator==(const boolean_domain &, const boolean_domain &) = default;
+
+    static constexpr mask_t false_bit = 1;
+    static constexpr mask_t true_bit = 2;
+    static constexpr mask_t full_mask = false_bit | true_bit;
+
+  private:
+    static constexpr mask_t bit_of(bool value) { return value ? true_bit : false_bit; }
+
+    mask_t m_mask = 0;
+};
+
+}// namespace solver
@@ -0,0 +1,33 @@
+#pragma once
+#include <charconv>
+#include <docopt/docopt.h>
+#include <fmt/format.h>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace solver {
+
+/**
+ * Parses the whole value of a command-line option as a non-negative number that fits number_t.
+ * Unlike std::stoul, negative values are rejected instead of wrapping, and so is trailing junk.
+ */
+template<typename number_t>
+number_t parse_number_option(const std::map<std::string, docopt::value> &args, const char *option)
+{
+    const std::string text = args.at(option).asString();
+    number_t number = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+    if (error == std::errc::result_out_of_range) {
+        throw std::out_of_range(fmt::format(
+            "{}={} is out of range, the maximum is {}", option, text, std::numeric_limits<number_t>::max()));
+    }
+    if (error != std::errc{} || end != text.data() + text.size()) {
+        throw std::invalid_argument(fmt::format("{}={} is not a non-negative integer", option, text));
+    }
+    return number;
+}
+
+}// namespace solver
@@ -0,0 +1,78 @@
+#pragma once
+#include "components.hpp"
+#include "model_count.hpp"
+#include "parallel_for.hpp"
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace solver {
+
+namespace detail {
+    template<typename solver_t>
+    solver_t make_component_solver(const cnf_component &component, const typename solver_t::domain_type &domain)
+    {
+        solver_t component_solver(static_cast<unsigned>(component.variables.size()), domain);
+        for (const std::vector<int> &clause : component.clauses) { component_solver.add_clause(clause); }
+        return component_solver;
+    }
+}// namespace detail
+
+/**
+ * Solves each component with its own solver_t, concurrently, and merges the solutions into a model of the
+ * whole formula. Returns std::nullopt if any of the components is unsatisfiable.
+ */
+template<typename solver_t>
+std::optional<std::vector<bool>> solve_components(unsigned variables,
+    const std::vector<cnf_component> &components,
+    const typename solver_t::domain_type &domain,
+    unsigned threads)
+{
+    std::vector<std::vector<bool>> component_models(components.size());
+    std::atomic<bool> unsat{ false };
+    parallel_for(components.size(), threads, [&](size_t index) {
+        if (unsat) {
+            return;
+        }
+        solver_t component_solver = detail::make_component_solver<solver_t>(components[index], domain);
+        if (!component_solver.solve()) {
+            unsat = true;
+            return;
+        }
+        std::vector<bool> &component_model = component_models[index];
+        for (unsigned i = 0; i != component_solver.num_variables(); ++i) {
+            component_model.push_back(component_solver.get_value(i));
+        }
+    });
+    if (unsat) {
+        return std::nullopt;
+    }
+
+    std::vector<bool> model(variables, false);
+    for (size_t index = 0; index != components.size(); ++index) {
+        const std::vector<unsigned> &component_variables = components[index].variables;
+        for (size_t i = 0; i != component_variables.size(); ++i) {
+            model[component_variables[i]] = component_models[index][i];
+        }
+    }
+    return model;
+}
+
+/**
+ * Counts the solutions of each component concurrently, the count of the whole formula is their product.
+ */
+template<typename solver_t>
+model_count count_components(const std::vector<cnf_component> &components,
+    const typename solver_t::domain_type &domain,
+    unsigned threads)
+{
+    std::vector<model_count> counts(components.size());
+    parallel_for(components.size(), threads, [&](size_t index) {
+        counts[index] = detail::make_component_solver<solver_t>(components[index], domain).count_solutions();
+    });
+    model_count total(1);
+    for (const model_count &count : counts) { total *= count; }
+    return total;
+}
+
+}// namespace solver
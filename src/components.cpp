@@ -0,0 +1,93 @@
+#include "components.hpp"
+#include <cstdlib>
+#include <fmt/format.h>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace solver {
+
+union_find::union_find(size_t size) : m_parents(size), m_sizes(size, 1)
+{
+    std::iota(m_parents.begin(), m_parents.end(), size_t{ 0 });
+}
+
+size_t union_find::find(size_t element)
+{
+    while (m_parents[element] != element) {
+        m_parents[element] = m_parents[m_parents[element]];
+        element = m_parents[element];
+    }
+    return element;
+}
+
+void union_find::unite(size_t first, size_t second)
+{
+    first = find(first);
+    second = find(second);
+    if (first == second) {
+        return;
+    }
+    if (m_sizes[first] < m_sizes[second]) {
+        std::swap(first, second);
+    }
+    m_parents[second] = first;
+    m_sizes[first] += m_sizes[second];
+}
+
+std::vector<cnf_component> split_components(unsigned variables, const std::vector<std::vector<int>> &clauses)
+{
+    auto variable_of = [variables](int literal) {
+        const auto variable = static_cast<unsigned>(std::abs(literal)) - 1;
+        if (literal == 0 || variable >= variables) {
+            throw std::out_of_range(
+                fmt::format("Literal {} is out of range for a formula of {} variables", literal, variables));
+        }
+        return variable;
+    };
+    union_find sets(variables);
+    std::vector<bool> constrained(variables, false);
+    for (const std::vector<int> &clause : clauses) {
+        for (int literal : clause) {
+            constrained[variable_of(literal)] = true;
+            sets.unite(variable_of(clause.front()), variable_of(literal));
+        }
+    }
+
+    constexpr unsigned no_component = ~0U;
+    std::vector<unsigned> component_of_root(variables, no_component);
+    std::vector<unsigned> index_in_component(variables, 0);
+    std::vector<cnf_component> components;
+    unsigned free_component = no_component;
+    for (unsigned variable = 0; variable != variables; ++variable) {
+        unsigned &component = constrained[variable] ? component_of_root[sets.find(variable)] : free_component;
+        if (component == no_component) {
+            component = static_cast<unsigned>(components.size());
+            components.emplace_back();
+        }
+        index_in_component[variable] = static_cast<unsigned>(components[component].variables.size());
+        components[component].variables.push_back(variable);
+    }
+
+    unsigned empty_clause_component = no_component;
+    for (const std::vector<int> &clause : clauses) {
+        if (clause.empty()) {
+            if (empty_clause_component == no_component) {
+                empty_clause_component = static_cast<unsigned>(components.size());
+                components.emplace_back();
+            }
+            components[empty_clause_component].clauses.emplace_back();
+            continue;
+        }
+        std::vector<int> renumbered;
+        renumbered.reserve(clause.size());
+        for (int literal : clause) {
+            const int local_variable = static_cast<int>(index_in_component[variable_of(literal)]) + 1;
+            renumbered.push_back(literal > 0 ? local_variable : -local_variable);
+        }
+        components[component_of_root[sets.find(variable_of(clause.front()))]].clauses.push_back(std::move(renumbered));
+    }
+    return components;
+}
+
+}// namespace solver
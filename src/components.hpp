@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace solver {
+
+/**
+ * Disjoint sets over 0..size-1, with path halving and union by size.
+ */
+class union_find
+{
+  public:
+    explicit union_find(size_t size);
+    size_t find(size_t element);
+    void unite(size_t first, size_t second);
+
+  private:
+    std::vector<size_t> m_parents;
+    std::vector<size_t> m_sizes;
+};
+
+/**
+ * A variable-disjoint part of a CNF formula.
+ * The clauses are renumbered, so that literal +-(i+1) refers to the original variable variables[i].
+ */
+struct cnf_component
+{
+    std::vector<unsigned> variables;
+    std::vector<std::vector<int>> clauses;
+};
+
+/**
+ * Splits a formula, given as DIMACS literal lists, into variable-disjoint components.
+ * Every variable belongs to exactly one component, and variables in ascending order within it. Variables that
+ * appear in no clause are collected into a single component without clauses, and empty clauses are kept in a
+ * component without variables.
+ */
+std::vector<cnf_component> split_components(unsigned variables, const std::vector<std::vector<int>> &clauses);
+
+}// namespace solver
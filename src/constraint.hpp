@@ -1,5 +1,8 @@
 #pragma once
+#include <algorithm>
+#include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -12,7 +15,7 @@ concept constraint_state = requires(T a)
     typename T::parameter_t;
     typename T::domain_type;
     typename T::domain_type::value_type;
-    std::integral<typename T::param_index_t>;
+    requires std::integral<typename T::param_index_t>;
     {
         a.get_value(std::declval<typename T::parameter_t>())
         } -> std::same_as<typename T::domain_type::value_type>;
@@ -31,9 +34,45 @@ concept propagating_constraint_state = constraint_state<T> && requires(T a)
     { a.unregister_watch(std::declval<typename T::parameter_t>()) };
 };
 
+template<typename T>
+concept backtrackable_constraint_state = constraint_state<T> && requires(T a)
+{
+    { a.new_level() };
+    { a.backtrack() };
+    {
+        a.level()
+        } -> std::convertible_to<std::size_t>;
+    {
+        a.trail_size()
+        } -> std::convertible_to<std::size_t>;
+};
+
 template<typename T>
 concept bool_domain = std::is_same_v<typename T::domain_type::value_type, bool>;
 
+template<typename T>
+concept integral_domain = !bool_domain<T> && std::integral<typename T::domain_type::value_type>;
+
+template<typename Domain> typename Domain::value_type domain_min(const Domain &domain)
+{
+    assert(domain.begin() != domain.end());
+    if constexpr (requires { domain.min(); }) {
+        return domain.min();
+    } else {
+        return *std::min_element(domain.begin(), domain.end());
+    }
+}
+
+template<typename Domain> typename Domain::value_type domain_max(const Domain &domain)
+{
+    assert(domain.begin() != domain.end());
+    if constexpr (requires { domain.max(); }) {
+        return domain.max();
+    } else {
+        return *std::max_element(domain.begin(), domain.end());
+    }
+}
+
 
 enum class propagation_result_t : int8_t { UNSAT, CONSISTENT, SAT };
 
@@ -41,18 +80,17 @@ template<typename T>
 concept constraint = requires(T c)
 {
     typename T::state_t;
-    constraint_state<typename T::state_t>;
+    requires constraint_state<typename T::state_t>;
     {
         c.is_satisfied(std::declval<typename T::state_t>())
         } -> std::same_as<bool>;
 };
 
 template<typename T>
-concept propagating_constraint = requires(T a)
+concept propagating_constraint = constraint<T> && requires(T a, typename T::state_t &state)
 {
-    constraint<T>;
     {
-        a.propagate(std::declval<typename T::state>(), 1)
+        a.propagate(state, 1U)
         } -> std::same_as<propagation_result_t>;
 };
 
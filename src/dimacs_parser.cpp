@@ -1,4 +1,5 @@
 #include "dimacs_parser.hpp"
+#include "parser_utils.hpp"
 #include <array>
 #include <cassert>
 #include <cstdio>
@@ -9,12 +10,6 @@
 
 namespace solver {
 
-std::string_view lstrip(std::string_view view)
-{
-    view.remove_prefix(std::min(view.find_first_not_of("\t "), view.size()));
-    return view;
-}
-
 void parse_dimacs_header(std::istream &in_stream,
     unsigned &line_num,
     const std::function<void(unsigned, unsigned)> &construct_problem)
@@ -2,10 +2,19 @@
 
 #include "binary_clause.hpp"
 #include "constraint.hpp"
+#include "model_count.hpp"
+#include "trail_constraint_state.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cinttypes>
 #include <cstdlib>
 #include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace solver {
@@ -40,23 +49,94 @@ template<typename Domain, std::integral VariableIndexType> class uniform_constra
     std::vector<domain_type> m_variables;
 };
 
-template<constraint_state constraint_state_t> class exhaustive_solver
+/// Selects truth-table leaf counting in count_solutions(), which only applies to binary_clause over Boolean domains.
+template<typename T, typename S>
+concept cnf_constraint = bool_domain<S> && std::same_as<T, binary_clause<S>>;
+
+template<constraint_state constraint_state_t, constraint constraint_t = binary_clause<constraint_state_t>>
+class exhaustive_solver
 {
   public:
     using domain_type = typename constraint_state_t::domain_type;
     using parameter_t = typename constraint_state_t::parameter_t;
+    using param_index_t = typename constraint_state_t::param_index_t;
     using value_type = typename domain_type::value_type;
 
-    exhaustive_solver(unsigned variables, const domain_type &domain) : m_state(variables, domain) {}
+    exhaustive_solver(unsigned variables, const domain_type &domain) : m_state(check_size(variables), domain) {}
+
+    bool solve()
+    {
+        order_variables();
+        return search(num_variables(), [this] { return all_satisfied(); });
+    }
+
+    /**
+     * Calls on_solution() for every solution, one at a time, without restarting the search.
+     * The solution can be read with get_value() inside on_solution(), which returns false to stop the enumeration.
+     * Returns the number of solutions that were reported.
+     */
+    template<std::invocable on_solution_t> size_t for_each_solution(on_solution_t on_solution)
+    {
+        order_variables();
+        size_t solutions = 0;
+        search(num_variables(), [this, &solutions, &on_solution] {
+            if (!all_satisfied()) {
+                return false;
+            }
+            ++solutions;
+            return !on_solution();
+        });
+        return solutions;
+    }
 
-    bool solve() { return try_assignments(0); }
+    /**
+     * Counts the solutions without materializing them. The search only branches on variables that appear in
+     * constraints, and each partial assignment that satisfies all the constraints counts for the product of
+     * the domain sizes of the unconstrained variables.
+     *
+     * For CNF, the last (up to 6) constrained variables are not branched on. Instead, each leaf evaluates every
+     * clause over all their assignments at once, as a 64-bit truth table, and counts the rows that satisfy all
+     * the clauses with a popcount.
+     */
+    model_count count_solutions()
+    {
+        order_variables();
+        size_t table_variables = 0;
+        if constexpr (counts_with_truth_tables) {
+            table_variables = std::min(max_table_variables, m_num_constrained);
+            m_table_positions.assign(num_variables(), not_in_table);
+            for (size_t j = 0; j != table_variables; ++j) {
+                m_table_positions[m_order[m_num_constrained - table_variables + j]] = static_cast<std::uint8_t>(j);
+            }
+        }
+        model_count count;
+        search(m_num_constrained - table_variables, [this, &count, table_variables] {
+            std::uint64_t leaf_assignments = 1;
+            if constexpr (counts_with_truth_tables) {
+                leaf_assignments = count_table_rows(table_variables);
+            } else if (!all_satisfied()) {
+                leaf_assignments = 0;
+            }
+            if (leaf_assignments == 0) {
+                return false;
+            }
+            model_count assignments(leaf_assignments);
+            for (size_t depth = m_num_constrained; depth != num_variables(); ++depth) {
+                assignments *= static_cast<model_count::limb_t>(m_state.get_domain(variable_at(depth)).size());
+            }
+            count += assignments;
+            return false;
+        });
+        return count;
+    }
 
     void add_clause(const std::vector<int> &literals)
+        requires std::same_as<constraint_t, binary_clause<constraint_state_t>>
     {
         std::vector<parameter_t> parameters;
         parameters.reserve(literals.size());
         std::transform(literals.begin(), literals.end(), std::back_inserter(parameters), [](int literal) {
-            return parameter_t{ static_cast<value_type>(std::abs(literal) - 1) };
+            return to_parameter(static_cast<unsigned>(std::abs(literal) - 1));
         });
 
         std::vector<bool> positive_literals;
@@ -65,32 +145,222 @@ template<constraint_state constraint_state_t> class exhaustive_solver
             return literal > 0;
         });
 
-        m_clauses.emplace_back(binary_clause<constraint_state_t>(parameters, positive_literals));
+        add_constraint(constraint_t(parameters, positive_literals));
     }
-    value_type get_value(unsigned index) const { return m_state.get_value(parameter_t{ static_cast<uint8_t>(index) }); }
+    void add_constraint(constraint_t constraint)
+    {
+        m_constraints.push_back(std::move(constraint));
+        m_order.clear();
+    }
+    void set_domain(unsigned index, const domain_type &domain)
+    {
+        if constexpr (backtrackable_constraint_state<constraint_state_t>) {
+            // A search that stopped at a solution left its levels open, and the next search backtracks them all,
+            // so the change must be made at the root to be permanent.
+            while (m_state.level() != 0) { m_state.backtrack(); }
+        } else if (!m_root_domains.empty()) {
+            m_root_domains[index] = domain;
+        }
+        m_state.set_domain(to_parameter(index), domain);
+    }
+    value_type get_value(unsigned index) const { return m_state.get_value(to_parameter(index)); }
     size_t num_variables() const { return m_state.size(); }
 
+    static parameter_t to_parameter(size_t index) { return parameter_t{ static_cast<param_index_t>(index) }; }
+
   private:
-    bool try_assignments(uint8_t depth)
+    static constexpr bool counts_with_truth_tables = cnf_constraint<constraint_t, constraint_state_t>;
+    static constexpr size_t max_table_variables = 6;
+    static constexpr std::uint8_t not_in_table = std::numeric_limits<std::uint8_t>::max();
+    // Row r of a truth table assigns bit j of r to table variable j, so column j is the set of rows where it is true.
+    static constexpr std::array<std::uint64_t, max_table_variables> table_columns = { 0xaaaaaaaaaaaaaaaaU,
+        0xccccccccccccccccU,
+        0xf0f0f0f0f0f0f0f0U,
+        0xff00ff00ff00ff00U,
+        0xffff0000ffff0000U,
+        0xffffffff00000000U };
+
+    static unsigned check_size(unsigned variables)
+    {
+        if (variables != 0 && std::cmp_greater(variables - 1, std::numeric_limits<param_index_t>::max())) {
+            throw std::out_of_range(std::to_string(variables) + " variables do not fit the solver's index type");
+        }
+        return variables;
+    }
+
+    // Runs the search, calling on_leaf() for every assignment of the first leaf_depth variables (in search order)
+    // that propagation does not reject. on_leaf() checks the constraints that it needs. The search stops, and
+    // returns true, once on_leaf() returns true.
+    template<typename on_leaf_t> bool search(size_t leaf_depth, on_leaf_t on_leaf)
+    {
+        if constexpr (backtrackable_constraint_state<constraint_state_t>) {
+            // Start from the root, even if a previous search stopped at a solution.
+            while (m_state.level() != 0) { m_state.backtrack(); }
+            m_state.new_level();
+            if (propagate() && try_assignments(0, leaf_depth, on_leaf)) {
+                return true;
+            }
+            m_state.backtrack();
+            return false;
+        } else {
+            // A search that stopped at a solution left it assigned, so that get_value() can read it.
+            if (!m_root_domains.empty()) {
+                for (size_t i = 0; i != num_variables(); ++i) {
+                    m_state.set_domain(to_parameter(i), m_root_domains[i]);
+                }
+                m_root_domains.clear();
+            }
+            std::vector<domain_type> root_domains;
+            root_domains.reserve(num_variables());
+            for (size_t i = 0; i != num_variables(); ++i) {
+                root_domains.push_back(m_state.get_domain(to_parameter(i)));
+            }
+            if (try_assignments(0, leaf_depth, on_leaf)) {
+                m_root_domains = std::move(root_domains);
+                return true;
+            }
+            return false;
+        }
+    }
+
+    // Search order: the variables that appear in constraints come first, keeping their relative order.
+    void order_variables()
+    {
+        if (!m_order.empty() || num_variables() == 0) {
+            return;
+        }
+        std::vector<bool> constrained(num_variables(), false);
+        for (const constraint_t &constraint : m_constraints) {
+            for (unsigned i = 0; i != constraint.num_parameters(); ++i) {
+                constrained.at(constraint.get_parameter(i).variable_index) = true;
+            }
+        }
+        m_order.resize(num_variables());
+        std::iota(m_order.begin(), m_order.end(), size_t{ 0 });
+        auto first_free = std::stable_partition(
+            m_order.begin(), m_order.end(), [&constrained](size_t index) { return constrained[index]; });
+        m_num_constrained = static_cast<size_t>(std::distance(m_order.begin(), first_free));
+    }
+
+    parameter_t variable_at(size_t depth) const { return to_parameter(m_order[depth]); }
+
+    // The number of assignments of the table variables that satisfy all the clauses, given the assigned variables.
+    std::uint64_t count_table_rows(size_t table_variables) const
     {
-        if (depth >= m_state.size()) {
-            return std::all_of(begin(m_clauses), end(m_clauses), [this](const auto &constraint) {
-                return constraint.is_satisfied(m_state);
-            });
+        constexpr std::uint64_t all_rows = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t rows = table_variables == max_table_variables ? all_rows : (1ULL << (1U << table_variables)) - 1;
+        const size_t first_depth = m_num_constrained - table_variables;
+        for (size_t j = 0; j != table_variables; ++j) {
+            const domain_type &domain = m_state.get_domain(variable_at(first_depth + j));
+            if (domain.count(true) == 0) {
+                rows &= ~table_columns[j];
+            }
+            if (domain.count(false) == 0) {
+                rows &= table_columns[j];
+            }
         }
+        for (const constraint_t &clause : m_constraints) {
+            if (rows == 0) {
+                break;
+            }
+            std::uint64_t satisfying = 0;
+            for (unsigned i = 0; i != clause.num_parameters(); ++i) {
+                const parameter_t param = clause.get_parameter(i);
+                const bool positive = clause.is_positive_literal(i);
+                const std::uint8_t position = m_table_positions[param.variable_index];
+                if (position != not_in_table) {
+                    satisfying |= positive ? table_columns[position] : ~table_columns[position];
+                } else if (m_state.get_value(param) == positive) {
+                    satisfying = all_rows;
+                    break;
+                }
+            }
+            rows &= satisfying;
+        }
+        return static_cast<std::uint64_t>(std::popcount(rows));
+    }
 
-        domain_type saved_domain = m_state.get_domain(parameter_t{ depth });
-        for (value_type val : saved_domain) {
-            m_state.set_value(parameter_t{ depth }, val);
-            if (try_assignments(depth + 1)) {
+    bool all_satisfied() const
+    {
+        return std::all_of(begin(m_constraints), end(m_constraints), [this](const auto &constraint) {
+            return constraint.is_satisfied(m_state);
+        });
+    }
+
+    template<typename on_leaf_t> bool try_assignments(size_t depth, size_t leaf_depth, on_leaf_t &on_leaf)
+    {
+        if (depth >= leaf_depth) {
+            return on_leaf();
+        }
+
+        if constexpr (backtrackable_constraint_state<constraint_state_t>) {
+            return try_assignments_on_trail(depth, leaf_depth, on_leaf);
+        } else {
+            const parameter_t param = variable_at(depth);
+            domain_type saved_domain = m_state.get_domain(param);
+            for (value_type val : saved_domain) {
+                m_state.set_value(param, val);
+                if (try_assignments(depth + 1, leaf_depth, on_leaf)) {
+                    return true;
+                }
+            }
+            m_state.set_domain(param, saved_domain);
+            return false;
+        }
+    }
+
+    // Branches on 'variable = value' and then on 'variable != value', where each branch is a trail level,
+    // so that undoing a branch also undoes everything that was propagated from it.
+    template<typename on_leaf_t> bool try_assignments_on_trail(size_t depth, size_t leaf_depth, on_leaf_t &on_leaf)
+    {
+        const parameter_t param = variable_at(depth);
+        while (m_state.get_domain(param).size() != 0) {
+            const value_type val = *m_state.get_domain(param).begin();
+            m_state.new_level();
+            m_state.set_value(param, val);
+            if (propagate() && try_assignments(depth + 1, leaf_depth, on_leaf)) {
                 return true;
             }
+            m_state.backtrack();
+
+            if constexpr (requires { m_state.remove_value(param, val); }) {
+                m_state.remove_value(param, val);
+            } else {
+                domain_type remaining = m_state.get_domain(param);
+                remaining.erase(val);
+                m_state.set_domain(param, remaining);
+            }
+            if (!propagate()) {
+                return false;
+            }
         }
-        m_state.set_domain(parameter_t{ depth }, saved_domain);
         return false;
     }
 
+    // Propagates all the constraints until nothing changes, returns false if any of them is violated.
+    bool propagate()
+    {
+        if constexpr (propagating_constraint<constraint_t> && backtrackable_constraint_state<constraint_state_t>) {
+            size_t trail_size = 0;
+            do {
+                trail_size = m_state.trail_size();
+                for (constraint_t &constraint : m_constraints) {
+                    if (constraint.propagate(m_state, 0) == propagation_result_t::UNSAT) {
+                        return false;
+                    }
+                }
+            } while (trail_size != m_state.trail_size());
+        }
+        return true;
+    }
+
     constraint_state_t m_state;
-    std::vector<binary_clause<constraint_state_t>> m_clauses;
+    std::vector<constraint_t> m_constraints;
+    std::vector<size_t> m_order;
+    size_t m_num_constrained = 0;
+    // The domains to restore before the next search, when the state has no trail and the last search stopped early.
+    std::vector<domain_type> m_root_domains;
+    // The truth table column of each variable while counting, or not_in_table.
+    std::vector<std::uint8_t> m_table_positions;
 };
 }// namespace solver
@@ -0,0 +1,47 @@
+#pragma once
+#include "all_different.hpp"
+#include "constraint.hpp"
+#include "linear_inequality.hpp"
+#include <variant>
+
+namespace solver {
+
+/**
+ * Any of the finite-domain constraints, so that a solver can keep them in a single container.
+ */
+template<constraint_state state_template_t>
+requires integral_domain<state_template_t>
+class fd_constraint
+{
+  public:
+    using state_t = state_template_t;
+
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    fd_constraint(all_different<state_t> constraint) : m_constraint(std::move(constraint)) {}
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    fd_constraint(linear_inequality<state_t> constraint) : m_constraint(std::move(constraint)) {}
+
+    bool is_satisfied(const state_t &state) const
+    {
+        return std::visit([&state](const auto &constraint) { return constraint.is_satisfied(state); }, m_constraint);
+    }
+    propagation_result_t propagate(state_t &state, unsigned trigger_param)
+    {
+        return std::visit(
+            [&state, trigger_param](auto &constraint) { return constraint.propagate(state, trigger_param); },
+            m_constraint);
+    }
+    typename state_t::parameter_t get_parameter(unsigned index) const
+    {
+        return std::visit([index](const auto &constraint) { return constraint.get_parameter(index); }, m_constraint);
+    }
+    unsigned num_parameters() const
+    {
+        return std::visit([](const auto &constraint) { return constraint.num_parameters(); }, m_constraint);
+    }
+
+  private:
+    std::variant<all_different<state_t>, linear_inequality<state_t>> m_constraint;
+};
+
+}// namespace solver
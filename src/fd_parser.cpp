@@ -0,0 +1,209 @@
+#include "fd_parser.hpp"
+#include "parser_utils.hpp"
+#include <fmt/format.h>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solver {
+
+namespace {
+    void parse_fd_header(std::istream &in_stream,
+        unsigned &line_num,
+        const std::function<void(unsigned, unsigned)> &construct_problem,
+        unsigned &variables,
+        unsigned &values)
+    {
+        for (std::string line; std::getline(in_stream, line); ++line_num) {
+            std::string_view line_view = lstrip(line);
+            if (line_view.empty() || line_view[0] == 'c') {
+                continue;
+            }
+            std::istringstream line_stream{ std::string(line_view) };
+            std::string cmd;
+            std::string format;
+            line_stream >> cmd >> format;
+            if (!line_stream || cmd != "p" || format != "fd") {
+                throw std::runtime_error(fmt::format(
+                    "{}: Invalid fd input format, expecting a line prefix 'p fd ' but got '{}'", line_num, line_view));
+            }
+            int read_variables = 0;
+            int read_values = 0;
+            line_stream >> read_variables >> read_values;
+            if (!line_stream || read_variables < 0 || read_values <= 0) {
+                throw std::runtime_error(
+                    fmt::format("{}: Invalid fd input format, expecting a header 'p fd <variables: unsigned int> "
+                                "<values: positive int>' but got '{}'",
+                        line_num,
+                        line_view));
+            }
+            std::string tail;
+            line_stream >> tail;
+            if (!tail.empty()) {
+                throw std::runtime_error(
+                    fmt::format("{}: Invalid fd input format, junk after header '{}'", line_num, tail));
+            }
+            variables = static_cast<unsigned>(read_variables);
+            values = static_cast<unsigned>(read_values);
+            construct_problem(variables, values);
+            return;
+        }
+        throw std::runtime_error("Invalid fd input format - all lines are either empty or commented out");
+    }
+
+    unsigned read_variable(std::istream &line_stream, unsigned variables, unsigned line_num, std::string_view line_view)
+    {
+        int variable = 0;
+        if (!(line_stream >> variable) || variable <= 0 || std::cmp_greater(variable, variables)) {
+            throw std::runtime_error(fmt::format(
+                "{}: Expecting a variable in the range 1..{} in the line '{}'", line_num, variables, line_view));
+        }
+        return static_cast<unsigned>(variable - 1);
+    }
+
+    void expect_line_end(std::istream &line_stream, unsigned line_num, std::string_view line_view)
+    {
+        std::string tail;
+        line_stream >> tail;
+        if (!tail.empty()) {
+            throw std::runtime_error(
+                fmt::format("{}: Junk '{}' at the end of the line '{}'", line_num, tail, line_view));
+        }
+    }
+
+    void parse_domain(std::istream &line_stream,
+        unsigned line_num,
+        std::string_view line_view,
+        unsigned variables,
+        unsigned values,
+        const std::function<void(unsigned, unsigned, unsigned)> &restrict_domain)
+    {
+        const unsigned variable = read_variable(line_stream, variables, line_num, line_view);
+        int min_value = 0;
+        int max_value = 0;
+        line_stream >> min_value >> max_value;
+        if (!line_stream || min_value < 0 || max_value < min_value || std::cmp_greater_equal(max_value, values)) {
+            throw std::runtime_error(fmt::format(
+                "{}: Expecting a domain 'd <variable> <min> <max>' with 0 <= min <= max < {} but got '{}'",
+                line_num,
+                values,
+                line_view));
+        }
+        expect_line_end(line_stream, line_num, line_view);
+        restrict_domain(variable, static_cast<unsigned>(min_value), static_cast<unsigned>(max_value));
+    }
+
+    void parse_all_different(std::istream &line_stream,
+        unsigned line_num,
+        std::string_view line_view,
+        unsigned variables,
+        const std::function<void(const std::vector<unsigned> &)> &register_all_different)
+    {
+        std::vector<unsigned> all_different_variables;
+        while (true) {
+            int variable = 0;
+            if (!(line_stream >> variable)) {
+                throw std::runtime_error(
+                    fmt::format("{}: Missing 0 at the end of the line for line '{}'", line_num, line_view));
+            }
+            if (variable == 0) {
+                break;
+            }
+            if (variable < 0 || std::cmp_greater(variable, variables)) {
+                throw std::runtime_error(fmt::format(
+                    "{}: Expecting a variable in the range 1..{} in the line '{}'", line_num, variables, line_view));
+            }
+            all_different_variables.push_back(static_cast<unsigned>(variable - 1));
+        }
+        if (all_different_variables.empty()) {
+            throw std::runtime_error(fmt::format("{}: Empty alldiff in the line '{}'", line_num, line_view));
+        }
+        expect_line_end(line_stream, line_num, line_view);
+        register_all_different(all_different_variables);
+    }
+
+    void parse_linear(std::istream &line_stream,
+        unsigned line_num,
+        std::string_view line_view,
+        unsigned variables,
+        const std::function<void(const std::vector<linear_term> &, std::int64_t)> &register_linear)
+    {
+        std::vector<linear_term> terms;
+        std::string token;
+        while (line_stream >> token && token != "<=" && token != ">=" && token != "=") {
+            int coefficient = 0;
+            std::size_t parsed_chars = 0;
+            try {
+                coefficient = std::stoi(token, &parsed_chars);
+            } catch (const std::logic_error &) {
+                parsed_chars = 0;
+            }
+            if (parsed_chars != token.size()) {
+                throw std::runtime_error(
+                    fmt::format("{}: Invalid coefficient '{}' in the line '{}'", line_num, token, line_view));
+            }
+            // Normalization negates coefficients, so the range must be symmetric.
+            if (coefficient == std::numeric_limits<int>::min()) {
+                throw std::runtime_error(
+                    fmt::format("{}: Coefficient '{}' is out of range in the line '{}'", line_num, token, line_view));
+            }
+            terms.push_back({ coefficient, read_variable(line_stream, variables, line_num, line_view) });
+        }
+        const std::string relation = token;
+        std::int64_t bound = 0;
+        if (terms.empty() || !(line_stream >> bound)) {
+            throw std::runtime_error(fmt::format(
+                "{}: Expecting 'linear <coef> <variable>... <=|>=|= <bound>' but got '{}'", line_num, line_view));
+        }
+        if (bound == std::numeric_limits<std::int64_t>::min()) {
+            throw std::runtime_error(
+                fmt::format("{}: Bound {} is out of range in the line '{}'", line_num, bound, line_view));
+        }
+        expect_line_end(line_stream, line_num, line_view);
+
+        std::vector<linear_term> negated = terms;
+        for (linear_term &term : negated) { term.coefficient = -term.coefficient; }
+        if (relation != ">=") {
+            register_linear(terms, bound);
+        }
+        if (relation != "<=") {
+            register_linear(negated, -bound);
+        }
+    }
+}// namespace
+
+void parse_fd(std::istream &in_stream,
+    const std::function<void(unsigned, unsigned)> &construct_problem,
+    const std::function<void(unsigned, unsigned, unsigned)> &restrict_domain,
+    const std::function<void(const std::vector<unsigned> &)> &register_all_different,
+    const std::function<void(const std::vector<linear_term> &, std::int64_t)> &register_linear)
+{
+    unsigned line_num = 1;
+    unsigned variables = 0;
+    unsigned values = 0;
+    parse_fd_header(in_stream, line_num, construct_problem, variables, values);
+    std::string line;
+    for (++line_num; std::getline(in_stream, line); ++line_num) {
+        std::string_view line_view = lstrip(line);
+        if (line_view.empty() || line_view[0] == 'c') {
+            continue;
+        }
+        std::istringstream line_stream{ std::string(line_view) };
+        std::string cmd;
+        line_stream >> cmd;
+        if (cmd == "d") {
+            parse_domain(line_stream, line_num, line_view, variables, values, restrict_domain);
+        } else if (cmd == "alldiff") {
+            parse_all_different(line_stream, line_num, line_view, variables, register_all_different);
+        } else if (cmd == "linear") {
+            parse_linear(line_stream, line_num, line_view, variables, register_linear);
+        } else {
+            throw std::runtime_error(
+                fmt::format("{}: Unknown constraint '{}' in the line '{}'", line_num, cmd, line_view));
+        }
+    }
+}
+}// namespace solver
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+namespace solver {
+
+struct linear_term
+{
+    int coefficient;
+    unsigned variable;
+};
+
+/**
+ * Parses a finite-domain problem. The format follows the spirit of DIMACS:
+ *
+ *   c <comment>
+ *   p fd <variables> <values>          every variable ranges over 0 .. values-1
+ *   d <variable> <min> <max>           restricts the domain of a variable to min .. max
+ *   alldiff <variable>... 0            the variables take pairwise distinct values
+ *   linear <coef> <variable>... <op> <bound>   where op is one of <=, >=, =
+ *
+ * Variables are numbered from 1 in the input, but are reported 0-based to the callbacks.
+ * Linear constraints are normalized to the form sum(terms) <= bound, so '>=' negates the terms and
+ * '=' registers two inequalities. Coefficients and bounds must be representable when negated, so the minimal
+ * int coefficient and the minimal int64 bound are rejected.
+ */
+void parse_fd(std::istream &in_stream,
+    const std::function<void(unsigned, unsigned)> &construct_problem,
+    const std::function<void(unsigned, unsigned, unsigned)> &restrict_domain,
+    const std::function<void(const std::vector<unsigned> &)> &register_all_different,
+    const std::function<void(const std::vector<linear_term> &, std::int64_t)> &register_linear);
+}// namespace solver
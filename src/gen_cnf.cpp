@@ -0,0 +1,129 @@
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "cli_options.hpp"
+#include "instance_generator.hpp"
+#include <docopt/docopt.h>
+#include <fmt/format.h>
+
+// This file will be generated automatically when you run the CMake configuration step.
+#include <internal_use_only/config.hpp>
+
+static constexpr auto USAGE =
+    R"(Generate CNF instances in DIMACS format
+
+    Usage:
+          gen_cnf --ksat --variables=N (--clauses=M | --ratio=R) [--k=K] [--seed=S] [--output=FILE]
+          gen_cnf --pigeonhole --holes=N [--output=FILE]
+          gen_cnf --coloring --vertices=N --edges=M --colors=C [--seed=S] [--output=FILE]
+          gen_cnf --parity --variables=N --equations=M [--length=L] [--seed=S] [--output=FILE]
+          gen_cnf (-h | --help)
+          gen_cnf --version
+    Options:
+          -h --help       Show this screen.
+          --version       Show version.
+          --ksat          Uniform random k-SAT.
+          --pigeonhole    Unsatisfiable pigeonhole, of N+1 pigeons in N holes.
+          --coloring      Coloring of a random graph.
+          --parity        Random XOR equations with a planted solution, chained through auxiliary variables.
+          --variables=N   Number of variables.
+          --clauses=M     Number of clauses.
+          --ratio=R       Number of clauses, as a ratio of the number of variables.
+          --k=K           Literals per clause [default: 3].
+          --holes=N       Number of holes.
+          --vertices=N    Number of graph vertices.
+          --edges=M       Number of graph edges.
+          --colors=C      Number of colors.
+          --equations=M   Number of XOR equations.
+          --length=L      Variables per XOR equation [default: 3].
+          --seed=S        Random seed [default: 1].
+          --output=FILE   Output file, instead of the standard output.
+)";
+
+namespace {
+unsigned as_unsigned(const std::map<std::string, docopt::value> &args, const char *option)
+{
+    return solver::parse_number_option<unsigned>(args, option);
+}
+
+std::uint64_t as_uint64(const std::map<std::string, docopt::value> &args, const char *option)
+{
+    return solver::parse_number_option<std::uint64_t>(args, option);
+}
+
+std::uint64_t clauses_by_ratio(const std::map<std::string, docopt::value> &args, unsigned variables)
+{
+    const std::string text = args.at("--ratio").asString();
+    double ratio = 0;
+    std::size_t parsed_chars = 0;
+    try {
+        ratio = std::stod(text, &parsed_chars);
+    } catch (const std::logic_error &) {
+        parsed_chars = 0;
+    }
+    if (parsed_chars == 0 || parsed_chars != text.size() || !std::isfinite(ratio) || ratio < 0) {
+        throw std::invalid_argument(fmt::format("--ratio={} is not a finite non-negative number", text));
+    }
+    const double clauses = std::round(ratio * variables);
+    // 2^64 is exact as a double, and every smaller double converts to std::uint64_t.
+    if (clauses >= 18446744073709551616.0) {
+        throw std::out_of_range(fmt::format("--ratio={} gives too many clauses", text));
+    }
+    return static_cast<std::uint64_t>(clauses);
+}
+}// namespace
+
+int main(int argc, const char **argv)
+{
+    try {
+        std::map<std::string, docopt::value> args = docopt::docopt(USAGE,
+            { std::next(argv), std::next(argv, argc) },
+            true,// show help if requested
+            fmt::format("{} {}", myproject::cmake::project_name, myproject::cmake::project_version));
+
+        std::unique_ptr<std::ofstream> file;
+        if (args.at("--output")) {
+            file = std::make_unique<std::ofstream>(args.at("--output").asString(), std::ios::binary);
+            if (!*file) {
+                fmt::print(stderr, "Could not open file {}\n", args.at("--output").asString());
+                return 1;
+            }
+        }
+        std::ostream &out = file ? *file : std::cout;
+
+        if (args.at("--ksat").asBool()) {
+            const unsigned variables = as_unsigned(args, "--variables");
+            const std::uint64_t clauses =
+                args.at("--clauses") ? as_uint64(args, "--clauses") : clauses_by_ratio(args, variables);
+            solver::generate_random_ksat(out, variables, clauses, as_unsigned(args, "--k"), as_uint64(args, "--seed"));
+        } else if (args.at("--pigeonhole").asBool()) {
+            solver::generate_pigeonhole(out, as_unsigned(args, "--holes"));
+        } else if (args.at("--coloring").asBool()) {
+            solver::generate_graph_coloring(out,
+                as_unsigned(args, "--vertices"),
+                as_uint64(args, "--edges"),
+                as_unsigned(args, "--colors"),
+                as_uint64(args, "--seed"));
+        } else if (args.at("--parity").asBool()) {
+            solver::generate_parity(out,
+                as_unsigned(args, "--variables"),
+                as_uint64(args, "--equations"),
+                as_unsigned(args, "--length"),
+                as_uint64(args, "--seed"));
+        }
+        out.flush();
+        if (!out) {
+            fmt::print(stderr, "Failed writing the instance\n");
+            return 1;
+        }
+    } catch (const std::exception &e) {
+        fmt::print(stderr, "Error: {}\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,251 @@
+#include "instance_generator.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fmt/format.h>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace solver {
+
+namespace {
+    constexpr std::size_t writer_buffer_size = std::size_t{ 1 } << 16U;
+
+    int as_literal(std::uint64_t variable_index, bool positive)
+    {
+        const int variable = static_cast<int>(variable_index + 1);
+        return positive ? variable : -variable;
+    }
+
+    void check_variables(std::uint64_t variables)
+    {
+        if (variables > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+            throw std::invalid_argument(fmt::format("{} variables do not fit in DIMACS literals", variables));
+        }
+    }
+
+    // Header counts are products of user input, which must not wrap around.
+    std::uint64_t checked_multiply(std::uint64_t first, std::uint64_t second, std::string_view what)
+    {
+        if (second != 0 && first > std::numeric_limits<std::uint64_t>::max() / second) {
+            throw std::invalid_argument(fmt::format("The number of {} overflows 64 bits", what));
+        }
+        return first * second;
+    }
+    std::uint64_t checked_add(std::uint64_t first, std::uint64_t second, std::string_view what)
+    {
+        if (first > std::numeric_limits<std::uint64_t>::max() - second) {
+            throw std::invalid_argument(fmt::format("The number of {} overflows 64 bits", what));
+        }
+        return first + second;
+    }
+
+    // Picks 'count' distinct variables out of 'variables'; count is small, so rejection is cheaper than a shuffle.
+    void pick_distinct(random_source &random, unsigned variables, std::vector<unsigned> &picked, unsigned count)
+    {
+        picked.clear();
+        while (picked.size() != count) {
+            const auto candidate = static_cast<unsigned>(random.below(variables));
+            if (std::find(picked.begin(), picked.end(), candidate) == picked.end()) {
+                picked.push_back(candidate);
+            }
+        }
+    }
+}// namespace
+
+dimacs_writer::dimacs_writer(std::ostream &out, unsigned variables, std::uint64_t clauses)
+    : m_out(out), m_expected_clauses(clauses)
+{
+    m_buffer.reserve(writer_buffer_size);
+    append(fmt::format("p cnf {} {}\n", variables, clauses));
+}
+
+dimacs_writer::~dimacs_writer()
+{
+    if (!m_finished) {
+        flush();
+    }
+}
+
+void dimacs_writer::add_clause(std::span<const int> literals)
+{
+    // Sign, digits and the separating space.
+    std::array<char, std::numeric_limits<int>::digits10 + 3> digits{};
+    for (int literal : literals) {
+        char *const end = std::to_chars(digits.data(), digits.data() + digits.size() - 1, literal).ptr;
+        *end = ' ';
+        append(std::string_view(digits.data(), static_cast<size_t>(end - digits.data()) + 1));
+    }
+    append("0\n");
+    ++m_written_clauses;
+}
+
+void dimacs_writer::finish()
+{
+    flush();
+    m_finished = true;
+    if (m_written_clauses != m_expected_clauses) {
+        throw std::logic_error(
+            fmt::format("Wrote {} clauses, but the header says {}", m_written_clauses, m_expected_clauses));
+    }
+}
+
+void dimacs_writer::append(std::string_view text)
+{
+    if (m_buffer.size() + text.size() > writer_buffer_size) {
+        flush();
+    }
+    m_buffer.insert(m_buffer.end(), text.begin(), text.end());
+}
+
+void dimacs_writer::flush()
+{
+    m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_buffer.clear();
+}
+
+void generate_random_ksat(std::ostream &out, unsigned variables, std::uint64_t clauses, unsigned k, std::uint64_t seed)
+{
+    check_variables(variables);
+    if (k == 0 || k > variables) {
+        throw std::invalid_argument(fmt::format("Can't generate {}-SAT clauses over {} variables", k, variables));
+    }
+    random_source random(seed);
+    dimacs_writer writer(out, variables, clauses);
+    std::vector<unsigned> picked;
+    std::vector<int> clause(k);
+    for (std::uint64_t i = 0; i != clauses; ++i) {
+        pick_distinct(random, variables, picked, k);
+        for (unsigned literal = 0; literal != k; ++literal) {
+            clause[literal] = as_literal(picked[literal], random.coin());
+        }
+        writer.add_clause(clause);
+    }
+    writer.finish();
+}
+
+void generate_pigeonhole(std::ostream &out, unsigned holes)
+{
+    const std::uint64_t pigeons = std::uint64_t{ holes } + 1;
+    check_variables(pigeons * holes);
+    auto variable = [holes](std::uint64_t pigeon, std::uint64_t hole) { return pigeon * holes + hole; };
+    dimacs_writer writer(out, static_cast<unsigned>(pigeons * holes), pigeons + holes * pigeons * (pigeons - 1) / 2);
+    std::vector<int> clause;
+    for (std::uint64_t pigeon = 0; pigeon != pigeons; ++pigeon) {
+        clause.clear();
+        for (unsigned hole = 0; hole != holes; ++hole) { clause.push_back(as_literal(variable(pigeon, hole), true)); }
+        writer.add_clause(clause);
+    }
+    for (unsigned hole = 0; hole != holes; ++hole) {
+        for (std::uint64_t first = 0; first != pigeons; ++first) {
+            for (std::uint64_t second = first + 1; second != pigeons; ++second) {
+                const std::array<int, 2> at_most_one{ as_literal(variable(first, hole), false),
+                    as_literal(variable(second, hole), false) };
+                writer.add_clause(at_most_one);
+            }
+        }
+    }
+    writer.finish();
+}
+
+void generate_graph_coloring(std::ostream &out,
+    unsigned vertices,
+    std::uint64_t edges,
+    unsigned colors,
+    std::uint64_t seed)
+{
+    check_variables(std::uint64_t{ vertices } * colors);
+    if (edges != 0 && vertices < 2) {
+        throw std::invalid_argument("Edges require at least two vertices");
+    }
+    auto variable = [colors](std::uint64_t vertex, unsigned color) { return vertex * colors + color; };
+    const std::uint64_t vertex_clauses = std::uint64_t{ vertices } * (1 + std::uint64_t{ colors } * (colors - 1) / 2);
+    dimacs_writer writer(
+        out, vertices * colors, checked_add(vertex_clauses, checked_multiply(edges, colors, "clauses"), "clauses"));
+    std::vector<int> clause;
+    for (unsigned vertex = 0; vertex != vertices; ++vertex) {
+        clause.clear();
+        for (unsigned color = 0; color != colors; ++color) {
+            clause.push_back(as_literal(variable(vertex, color), true));
+        }
+        writer.add_clause(clause);
+        for (unsigned first = 0; first != colors; ++first) {
+            for (unsigned second = first + 1; second != colors; ++second) {
+                const std::array<int, 2> at_most_one{ as_literal(variable(vertex, first), false),
+                    as_literal(variable(vertex, second), false) };
+                writer.add_clause(at_most_one);
+            }
+        }
+    }
+    random_source random(seed);
+    for (std::uint64_t edge = 0; edge != edges; ++edge) {
+        const std::uint64_t from = random.below(vertices);
+        const std::uint64_t to = (from + 1 + random.below(vertices - 1)) % vertices;
+        for (unsigned color = 0; color != colors; ++color) {
+            const std::array<int, 2> different{ as_literal(variable(from, color), false),
+                as_literal(variable(to, color), false) };
+            writer.add_clause(different);
+        }
+    }
+    writer.finish();
+}
+
+void generate_parity(std::ostream &out,
+    unsigned variables,
+    std::uint64_t equations,
+    unsigned length,
+    std::uint64_t seed)
+{
+    if (length == 0 || length > variables) {
+        throw std::invalid_argument(
+            fmt::format("Can't generate XOR equations of length {} over {} variables", length, variables));
+    }
+    const std::uint64_t auxiliaries = length >= 2 ? length - 2 : 0;
+    const std::uint64_t total_variables =
+        checked_add(variables, checked_multiply(equations, auxiliaries, "variables"), "variables");
+    check_variables(total_variables);
+    const std::uint64_t clauses_per_equation = length == 1 ? 1 : 4 * auxiliaries + 2;
+    dimacs_writer writer(
+        out, static_cast<unsigned>(total_variables), checked_multiply(equations, clauses_per_equation, "clauses"));
+
+    random_source random(seed);
+    std::vector<bool> planted(variables);
+    for (unsigned variable = 0; variable != variables; ++variable) { planted[variable] = random.coin(); }
+
+    std::vector<unsigned> picked;
+    std::uint64_t next_auxiliary = variables;
+    for (std::uint64_t equation = 0; equation != equations; ++equation) {
+        pick_distinct(random, variables, picked, length);
+        bool parity = false;
+        for (unsigned variable : picked) { parity = parity != planted[variable]; }
+        if (length == 1) {
+            const std::array<int, 1> unit{ as_literal(picked[0], parity) };
+            writer.add_clause(unit);
+            continue;
+        }
+        // running = x0 ^ x1 ^ ... through the auxiliary variables, and the last link asserts the parity.
+        std::uint64_t running = picked[0];
+        for (unsigned next = 1; next != length - 1; ++next) {
+            const std::uint64_t sum = next_auxiliary++;
+            const int t = as_literal(sum, true);
+            const int a = as_literal(running, true);
+            const int b = as_literal(picked[next], true);
+            const std::array<std::array<int, 3>, 4> definition{
+                { { -t, a, b }, { -t, -a, -b }, { t, -a, b }, { t, a, -b } }
+            };
+            for (const auto &clause : definition) { writer.add_clause(clause); }
+            running = sum;
+        }
+        const int a = as_literal(running, true);
+        const int b = as_literal(picked[length - 1], true);
+        const std::array<int, 2> first_clause{ parity ? a : -a, b };
+        const std::array<int, 2> second_clause{ parity ? -a : a, -b };
+        writer.add_clause(first_clause);
+        writer.add_clause(second_clause);
+    }
+    writer.finish();
+}
+
+}// namespace solver
@@ -0,0 +1,64 @@
+#pragma once
+#include "random_source.hpp"
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace solver {
+
+/**
+ * Writes DIMACS CNF through a fixed-size buffer, so that instances of any size are streamed
+ * without being held in memory. The number of clauses written must match the header.
+ */
+class dimacs_writer
+{
+  public:
+    dimacs_writer(std::ostream &out, unsigned variables, std::uint64_t clauses);
+    dimacs_writer(const dimacs_writer &) = delete;
+    dimacs_writer &operator=(const dimacs_writer &) = delete;
+    ~dimacs_writer();
+
+    void add_clause(std::span<const int> literals);
+    /// Flushes the buffer, and throws std::logic_error if the clause count does not match the header.
+    void finish();
+
+  private:
+    void append(std::string_view text);
+    void flush();
+
+    std::ostream &m_out;
+    std::vector<char> m_buffer;
+    std::uint64_t m_expected_clauses;
+    std::uint64_t m_written_clauses = 0;
+    bool m_finished = false;
+};
+
+/// Uniform random k-SAT: each clause has k distinct variables with random signs.
+void generate_random_ksat(std::ostream &out, unsigned variables, std::uint64_t clauses, unsigned k, std::uint64_t seed);
+
+/// The unsatisfiable pigeonhole formula, of holes + 1 pigeons in the given number of holes.
+void generate_pigeonhole(std::ostream &out, unsigned holes);
+
+/**
+ * Coloring of a random graph with the given number of vertices and edges (drawn independently, so duplicate
+ * edges are possible), where each vertex gets exactly one of the colors.
+ */
+void generate_graph_coloring(std::ostream &out,
+    unsigned vertices,
+    std::uint64_t edges,
+    unsigned colors,
+    std::uint64_t seed);
+
+/**
+ * A system of random XOR equations, each over 'length' distinct variables, with a planted solution so that it
+ * is satisfiable. Each equation is chained through auxiliary variables, as 4 clauses per link.
+ */
+void generate_parity(std::ostream &out,
+    unsigned variables,
+    std::uint64_t equations,
+    unsigned length,
+    std::uint64_t seed);
+
+}// namespace solver
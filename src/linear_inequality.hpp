@@ -0,0 +1,106 @@
+#pragma once
+#include "constraint.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace solver {
+
+/**
+ * The constraint sum(coefficient[i] * parameter[i]) <= bound over integral domains.
+ * Propagation is bounds-consistent: it removes every value whose contribution cannot fit in the bound,
+ * even when all the other parameters take their smallest contribution.
+ */
+template<constraint_state state_template_t>
+requires integral_domain<state_template_t>
+class linear_inequality
+{
+  public:
+    using state_t = state_template_t;
+    using parameter_t = typename state_t::parameter_t;
+    using domain_type = typename state_t::domain_type;
+    using value_type = typename domain_type::value_type;
+    using sum_t = std::int64_t;
+
+    linear_inequality(std::vector<parameter_t> parameters, std::vector<int> coefficients, sum_t bound)
+        : m_parameters(std::move(parameters)), m_coefficients(std::move(coefficients)), m_bound(bound)
+    {
+        if (m_parameters.size() != m_coefficients.size()) {
+            throw std::invalid_argument("linear_inequality requires a coefficient per parameter");
+        }
+    }
+
+    bool is_satisfied(const state_t &state) const
+    {
+        sum_t sum = 0;
+        for (unsigned i = 0; i != num_parameters(); ++i) { sum += contribution(i, state.get_value(m_parameters[i])); }
+        return sum <= m_bound;
+    }
+
+    propagation_result_t propagate(state_t &state, unsigned trigger_param)
+    {
+        if (trigger_param >= num_parameters()) {
+            throw std::out_of_range("trigger param is too big");
+        }
+        sum_t min_sum = 0;
+        sum_t max_sum = 0;
+        for (unsigned i = 0; i != num_parameters(); ++i) {
+            const domain_type &domain = state.get_domain(m_parameters[i]);
+            if (domain.size() == 0) {
+                return propagation_result_t::UNSAT;
+            }
+            min_sum += min_contribution(i, domain);
+            max_sum += max_contribution(i, domain);
+        }
+        if (min_sum > m_bound) {
+            return propagation_result_t::UNSAT;
+        }
+        if (max_sum <= m_bound) {
+            return propagation_result_t::SAT;
+        }
+        // Pruning a parameter only removes its large contributions, so min_sum is invariant during the loop.
+        const sum_t slack = m_bound - min_sum;
+        for (unsigned i = 0; i != num_parameters(); ++i) {
+            const domain_type &current = state.get_domain(m_parameters[i]);
+            const sum_t max_allowed = min_contribution(i, current) + slack;
+            if (max_contribution(i, current) <= max_allowed) {
+                continue;
+            }
+            domain_type domain = current;
+            for (value_type value : current) {
+                if (contribution(i, value) > max_allowed) {
+                    domain.erase(value);
+                }
+            }
+            state.set_domain(m_parameters[i], domain);
+        }
+        return propagation_result_t::CONSISTENT;
+    }
+
+    parameter_t get_parameter(unsigned index) const { return m_parameters[index]; }
+    int get_coefficient(unsigned index) const { return m_coefficients[index]; }
+    sum_t get_bound() const { return m_bound; }
+    unsigned num_parameters() const { return static_cast<unsigned>(m_parameters.size()); }
+
+  private:
+    sum_t contribution(unsigned index, value_type value) const
+    {
+        return static_cast<sum_t>(m_coefficients[index]) * static_cast<sum_t>(value);
+    }
+    sum_t min_contribution(unsigned index, const domain_type &domain) const
+    {
+        return m_coefficients[index] >= 0 ? contribution(index, domain_min(domain))
+                                          : contribution(index, domain_max(domain));
+    }
+    sum_t max_contribution(unsigned index, const domain_type &domain) const
+    {
+        return m_coefficients[index] >= 0 ? contribution(index, domain_max(domain))
+                                          : contribution(index, domain_min(domain));
+    }
+
+    std::vector<parameter_t> m_parameters;
+    std::vector<int> m_coefficients;
+    sum_t m_bound;
+};
+
+}// namespace solver
@@ -0,0 +1,135 @@
+#pragma once
+#include "aligned_allocator.hpp"
+#include "boolean_domain.hpp"
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace solver {
+
+/**
+ * A backtrackable state of Boolean variables, laid out for the propagation loop.
+ *
+ * The hot data is a single dense byte array indexed by literal (2 * variable + is_negative), which holds the
+ * domain mask of the literal's truth value, so that literal_mask(), is_true() and is_false() are one load
+ * without any branch on the literal's sign. Both literals of a variable share a cache line.
+ * Per-variable data that propagation rarely reads (decision level, reason, activity, saved phase) lives in
+ * separate arrays, so it does not dilute the cache lines of the hot array.
+ *
+ * With huge_pages, the literal array is aligned to 2MiB and advised to use transparent huge pages;
+ * otherwise it is aligned to a cache line.
+ */
+template<std::integral VariableIndexType, bool huge_pages = false> class literal_state
+{
+    using mask_t = boolean_domain::mask_t;
+    static constexpr std::size_t literal_alignment = huge_pages ? huge_page_size : cache_line_size;
+
+  public:
+    using domain_type = boolean_domain;
+    using value_type = bool;
+    using param_index_t = VariableIndexType;
+    struct parameter_t
+    {
+        VariableIndexType variable_index;
+    };
+    using literal_t = std::uint32_t;
+    static constexpr std::uint32_t no_reason = std::numeric_limits<std::uint32_t>::max();
+
+    explicit literal_state(unsigned variables, const domain_type &domain)
+        : m_literal_masks(2 * static_cast<std::size_t>(variables)), m_levels(variables, 0),
+          m_reasons(variables, no_reason), m_activities(variables, 0.0), m_saved_phases(variables, 0)
+    {
+        for (unsigned variable = 0; variable != variables; ++variable) { store_mask(variable, domain.mask()); }
+        m_trail.reserve(variables);
+        m_level_starts.reserve(variables + 1U);
+    }
+
+    static literal_t make_literal(parameter_t param, bool positive)
+    {
+        return 2 * static_cast<literal_t>(param.variable_index) + (positive ? 0U : 1U);
+    }
+
+    domain_type get_domain(parameter_t param) const
+    {
+        return domain_type::from_mask(m_literal_masks[make_literal(param, true)]);
+    }
+    value_type get_value(parameter_t param) const
+    {
+        assert(get_domain(param).size() == 1);
+        return is_true(make_literal(param, true));
+    }
+    void set_domain(parameter_t param, const domain_type &dom) { assign(param, dom.mask(), no_reason); }
+    void set_value(parameter_t param, value_type value, std::uint32_t reason = no_reason)
+    {
+        assign(param, value ? domain_type::true_bit : domain_type::false_bit, reason);
+    }
+    size_t size() const { return m_levels.size(); }
+
+    /// The values the literal can take, as a boolean_domain mask.
+    mask_t literal_mask(literal_t literal) const { return m_literal_masks[literal]; }
+    bool is_true(literal_t literal) const { return m_literal_masks[literal] == domain_type::true_bit; }
+    bool is_false(literal_t literal) const { return m_literal_masks[literal] == domain_type::false_bit; }
+
+    void new_level() { m_level_starts.push_back(static_cast<std::uint32_t>(m_trail.size())); }
+    void backtrack()
+    {
+        assert(!m_level_starts.empty());
+        const std::size_t level_start = m_level_starts.back();
+        m_level_starts.pop_back();
+        while (m_trail.size() != level_start) {
+            const trail_entry &entry = m_trail.back();
+            const literal_t positive = make_literal(parameter_t{ entry.variable_index }, true);
+            if (entry.old_mask == domain_type::full_mask && (is_true(positive) || is_false(positive))) {
+                m_saved_phases[entry.variable_index] = is_true(positive) ? 1 : 0;
+            }
+            store_mask(entry.variable_index, entry.old_mask);
+            m_trail.pop_back();
+        }
+    }
+    size_t level() const { return m_level_starts.size(); }
+    size_t trail_size() const { return m_trail.size(); }
+
+    /// The decision level at which the variable was last assigned.
+    std::uint32_t level_of(parameter_t param) const { return m_levels[param.variable_index]; }
+    std::uint32_t reason(parameter_t param) const { return m_reasons[param.variable_index]; }
+    double activity(parameter_t param) const { return m_activities[param.variable_index]; }
+    void bump_activity(parameter_t param, double increment) { m_activities[param.variable_index] += increment; }
+    /// The value the variable had before it was last unassigned by backtracking.
+    bool saved_phase(parameter_t param) const { return m_saved_phases[param.variable_index] != 0; }
+
+  private:
+    struct trail_entry
+    {
+        param_index_t variable_index;
+        mask_t old_mask;
+    };
+
+    void assign(parameter_t param, mask_t mask, std::uint32_t reason)
+    {
+        const std::size_t variable = param.variable_index;
+        if (!m_level_starts.empty()) {
+            m_trail.push_back({ param.variable_index, m_literal_masks[2 * variable] });
+        }
+        store_mask(variable, mask);
+        m_levels[variable] = static_cast<std::uint32_t>(level());
+        m_reasons[variable] = reason;
+    }
+    void store_mask(std::size_t variable, mask_t mask)
+    {
+        m_literal_masks[2 * variable] = mask;
+        m_literal_masks[2 * variable + 1] = static_cast<mask_t>(((mask & domain_type::false_bit) << 1U)
+                                                                 | ((mask & domain_type::true_bit) >> 1U));
+    }
+
+    std::vector<mask_t, aligned_allocator<mask_t, literal_alignment>> m_literal_masks;
+    std::vector<std::uint32_t> m_levels;
+    std::vector<std::uint32_t> m_reasons;
+    std::vector<double> m_activities;
+    std::vector<std::uint8_t> m_saved_phases;
+    std::vector<trail_entry> m_trail;
+    std::vector<std::uint32_t> m_level_starts;
+};
+
+}// namespace solver
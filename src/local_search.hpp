@@ -0,0 +1,280 @@
+#pragma once
+#include "random_source.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace solver {
+
+/// The outcome of local_search_solver::solve().
+enum class local_search_result { satisfiable, unsatisfiable, unknown };
+
+/**
+ * A stochastic local search for CNF formulas (ProbSAT).
+ *
+ * Starting from a random assignment, each step picks a random unsatisfied clause and flips one of its
+ * variables, chosen with a probability that falls with the variable's break count: the number of clauses
+ * that would become unsatisfied by the flip. Short clauses use the polynomial weight (eps + break)^-cb,
+ * longer ones the exponential weight cb^-break.
+ *
+ * All the data lives in flat arrays: clause literals and literal occurrences are stored back to back,
+ * with per-clause true-literal counts, per-variable break and make counts that are updated incrementally
+ * on every flip, and an unsatisfied-clause set that supports O(1) insertion and removal.
+ * Each clause also keeps the xor of its true variables, so that when exactly one literal is true its
+ * variable is known without scanning the clause.
+ *
+ * The search can only find models. The only unsatisfiability it reports is that of a formula with an empty clause.
+ * Literal occurrences and clauses are indexed by 32 bits, and add_clause() throws std::length_error beyond that.
+ */
+class local_search_solver
+{
+  public:
+    using literal_t = std::uint32_t;
+
+    explicit local_search_solver(unsigned variables, std::uint64_t seed = 1)
+        : m_variables(variables), m_random(seed), m_values(variables, 0)
+    {
+        m_clause_starts.push_back(0);
+    }
+
+    /// Adds a clause of DIMACS literals. Duplicate literals are dropped, and so are tautologies.
+    void add_clause(const std::vector<int> &literals)
+    {
+        m_scratch.clear();
+        for (const int literal : literals) {
+            const unsigned variable = static_cast<unsigned>(std::abs(literal));
+            if (variable == 0 || variable > m_variables) {
+                throw std::out_of_range(
+                    fmt::format("Literal {} is out of the range of {} variables", literal, m_variables));
+            }
+            m_scratch.push_back(2 * (variable - 1) + (literal < 0 ? 1U : 0U));
+        }
+        std::sort(m_scratch.begin(), m_scratch.end());
+        m_scratch.erase(std::unique(m_scratch.begin(), m_scratch.end()), m_scratch.end());
+        for (size_t i = 1; i < m_scratch.size(); ++i) {
+            if ((m_scratch[i] ^ 1U) == m_scratch[i - 1]) {
+                return;
+            }
+        }
+        // The last clause index is reserved as the not_unsatisfied marker.
+        if (m_scratch.size() > max_offset - m_clause_literals.size() || num_clauses() + 1 >= max_offset) {
+            throw std::length_error(
+                fmt::format("Local search supports up to {} literal occurrences and clauses", max_offset));
+        }
+        m_clause_literals.insert(m_clause_literals.end(), m_scratch.begin(), m_scratch.end());
+        m_clause_starts.push_back(static_cast<std::uint32_t>(m_clause_literals.size()));
+        m_max_clause_size = std::max(m_max_clause_size, static_cast<unsigned>(m_scratch.size()));
+    }
+
+    /**
+     * Searches for a model, flipping at most max_flips variables.
+     * Returns unknown when the budget runs out, which says nothing about satisfiability, and unsatisfiable
+     * only when there is an empty clause.
+     */
+    local_search_result solve(std::uint64_t max_flips)
+    {
+        m_flips = 0;
+        if (has_empty_clause()) {
+            return local_search_result::unsatisfiable;
+        }
+        build_occurrences();
+        initialize();
+        while (!m_unsatisfied.empty()) {
+            if (m_flips == max_flips) {
+                return local_search_result::unknown;
+            }
+            const std::uint32_t clause = m_unsatisfied[m_random.below(m_unsatisfied.size())];
+            flip(pick_variable(clause));
+            ++m_flips;
+        }
+        return local_search_result::satisfiable;
+    }
+
+    bool get_value(unsigned index) const { return m_values[index] != 0; }
+    size_t num_variables() const { return m_variables; }
+    size_t num_clauses() const { return m_clause_starts.size() - 1; }
+    /// The number of flips made by the last solve().
+    std::uint64_t flips() const { return m_flips; }
+    /// The number of clauses left unsatisfied by the current assignment.
+    size_t num_unsatisfied() const { return m_unsatisfied.size(); }
+    /// The number of clauses that flipping the variable would make unsatisfied, after solve().
+    unsigned break_count(unsigned variable) const { return m_breaks[variable]; }
+    /// The number of unsatisfied clauses that flipping the variable would satisfy, after solve().
+    unsigned make_count(unsigned variable) const { return m_makes[variable]; }
+
+  private:
+    static constexpr std::uint32_t not_unsatisfied = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t max_offset = std::numeric_limits<std::uint32_t>::max();
+    static constexpr double polynomial_eps = 1.0;
+    static constexpr double polynomial_cb = 2.38;
+    static constexpr double exponential_cb = 3.7;
+    static constexpr unsigned max_polynomial_clause_size = 3;
+
+    static unsigned variable_of(literal_t literal) { return literal >> 1U; }
+    bool is_true(literal_t literal) const { return m_values[variable_of(literal)] != (literal & 1U); }
+
+    bool has_empty_clause() const
+    {
+        for (size_t clause = 0; clause != num_clauses(); ++clause) {
+            if (m_clause_starts[clause] == m_clause_starts[clause + 1]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void build_occurrences()
+    {
+        m_occurrence_starts.assign(2 * static_cast<size_t>(m_variables) + 1, 0);
+        for (const literal_t literal : m_clause_literals) { ++m_occurrence_starts[literal + 1]; }
+        std::partial_sum(m_occurrence_starts.begin(), m_occurrence_starts.end(), m_occurrence_starts.begin());
+        m_occurrences.resize(m_clause_literals.size());
+        std::vector<std::uint32_t> next(m_occurrence_starts.begin(), std::prev(m_occurrence_starts.end()));
+        for (std::uint32_t clause = 0; clause != num_clauses(); ++clause) {
+            for (std::uint32_t i = m_clause_starts[clause]; i != m_clause_starts[clause + 1]; ++i) {
+                m_occurrences[next[m_clause_literals[i]]++] = clause;
+            }
+        }
+
+        // Weights are looked up by break count, which is bounded by the number of occurrences.
+        std::uint32_t max_occurrences = 0;
+        for (size_t literal = 0; literal + 1 < m_occurrence_starts.size(); ++literal) {
+            max_occurrences =
+                std::max(max_occurrences, m_occurrence_starts[literal + 1] - m_occurrence_starts[literal]);
+        }
+        m_weights.resize(max_occurrences + 1U);
+        for (unsigned breaks = 0; breaks != m_weights.size(); ++breaks) {
+            m_weights[breaks] = m_max_clause_size <= max_polynomial_clause_size
+                                    ? std::pow(polynomial_eps + breaks, -polynomial_cb)
+                                    : std::pow(exponential_cb, -static_cast<double>(breaks));
+        }
+    }
+
+    void initialize()
+    {
+        for (std::uint8_t &value : m_values) { value = m_random.coin() ? 1 : 0; }
+        m_true_counts.assign(num_clauses(), 0);
+        m_true_xors.assign(num_clauses(), 0);
+        m_breaks.assign(m_variables, 0);
+        m_makes.assign(m_variables, 0);
+        m_unsatisfied.clear();
+        m_unsatisfied_positions.assign(num_clauses(), not_unsatisfied);
+        for (std::uint32_t clause = 0; clause != num_clauses(); ++clause) {
+            for (std::uint32_t i = m_clause_starts[clause]; i != m_clause_starts[clause + 1]; ++i) {
+                const literal_t literal = m_clause_literals[i];
+                if (is_true(literal)) {
+                    ++m_true_counts[clause];
+                    m_true_xors[clause] ^= variable_of(literal);
+                }
+            }
+            if (m_true_counts[clause] == 0) {
+                make_unsatisfied(clause);
+            } else if (m_true_counts[clause] == 1) {
+                ++m_breaks[m_true_xors[clause]];
+            }
+        }
+    }
+
+    unsigned pick_variable(std::uint32_t clause)
+    {
+        const std::uint32_t begin = m_clause_starts[clause];
+        const std::uint32_t end = m_clause_starts[clause + 1];
+        m_probabilities.clear();
+        double total = 0;
+        for (std::uint32_t i = begin; i != end; ++i) {
+            total += m_weights[m_breaks[variable_of(m_clause_literals[i])]];
+            m_probabilities.push_back(total);
+        }
+        const double threshold = m_random.uniform() * total;
+        for (std::uint32_t i = begin; i + 1 < end; ++i) {
+            if (threshold < m_probabilities[i - begin]) {
+                return variable_of(m_clause_literals[i]);
+            }
+        }
+        return variable_of(m_clause_literals[end - 1]);
+    }
+
+    void flip(unsigned variable)
+    {
+        m_values[variable] ^= 1U;
+        const literal_t became_true = 2 * variable + (m_values[variable] != 0 ? 0U : 1U);
+        for (std::uint32_t i = m_occurrence_starts[became_true]; i != m_occurrence_starts[became_true + 1]; ++i) {
+            const std::uint32_t clause = m_occurrences[i];
+            const std::uint32_t old_count = m_true_counts[clause]++;
+            if (old_count == 0) {
+                make_satisfied(clause);
+                ++m_breaks[variable];
+            } else if (old_count == 1) {
+                --m_breaks[m_true_xors[clause]];
+            }
+            m_true_xors[clause] ^= variable;
+        }
+        const literal_t became_false = became_true ^ 1U;
+        for (std::uint32_t i = m_occurrence_starts[became_false]; i != m_occurrence_starts[became_false + 1]; ++i) {
+            const std::uint32_t clause = m_occurrences[i];
+            const std::uint32_t new_count = --m_true_counts[clause];
+            m_true_xors[clause] ^= variable;
+            if (new_count == 0) {
+                make_unsatisfied(clause);
+                --m_breaks[variable];
+            } else if (new_count == 1) {
+                ++m_breaks[m_true_xors[clause]];
+            }
+        }
+    }
+
+    void make_unsatisfied(std::uint32_t clause)
+    {
+        m_unsatisfied_positions[clause] = static_cast<std::uint32_t>(m_unsatisfied.size());
+        m_unsatisfied.push_back(clause);
+        for (std::uint32_t i = m_clause_starts[clause]; i != m_clause_starts[clause + 1]; ++i) {
+            ++m_makes[variable_of(m_clause_literals[i])];
+        }
+    }
+    void make_satisfied(std::uint32_t clause)
+    {
+        // Move the last unsatisfied clause into the hole, so that removal is O(1).
+        const std::uint32_t position = m_unsatisfied_positions[clause];
+        assert(position != not_unsatisfied);
+        const std::uint32_t last = m_unsatisfied.back();
+        m_unsatisfied[position] = last;
+        m_unsatisfied_positions[last] = position;
+        m_unsatisfied.pop_back();
+        m_unsatisfied_positions[clause] = not_unsatisfied;
+        for (std::uint32_t i = m_clause_starts[clause]; i != m_clause_starts[clause + 1]; ++i) {
+            --m_makes[variable_of(m_clause_literals[i])];
+        }
+    }
+
+    unsigned m_variables;
+    random_source m_random;
+    unsigned m_max_clause_size = 0;
+    std::uint64_t m_flips = 0;
+
+    std::vector<std::uint8_t> m_values;
+    std::vector<literal_t> m_clause_literals;
+    std::vector<std::uint32_t> m_clause_starts;
+    std::vector<std::uint32_t> m_occurrence_starts;
+    std::vector<std::uint32_t> m_occurrences;
+
+    std::vector<std::uint32_t> m_true_counts;
+    std::vector<std::uint32_t> m_true_xors;
+    std::vector<std::uint32_t> m_breaks;
+    std::vector<std::uint32_t> m_makes;
+    std::vector<std::uint32_t> m_unsatisfied;
+    std::vector<std::uint32_t> m_unsatisfied_positions;
+
+    std::vector<double> m_weights;
+    std::vector<double> m_probabilities;
+    std::vector<literal_t> m_scratch;
+};
+
+}// namespace solver
@@ -2,10 +2,19 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
-#include <set>
 
+#include "bitset_domain.hpp"
+#include "boolean_domain.hpp"
+#include "cli_options.hpp"
+#include "component_solver.hpp"
+#include "components.hpp"
 #include "dimacs_parser.hpp"
 #include "exhaustive_solver.hpp"
+#include "fd_constraint.hpp"
+#include "fd_parser.hpp"
+#include "literal_state.hpp"
+#include "local_search.hpp"
+#include "solver_dispatch.hpp"
 #include <docopt/docopt.h>
 #include <spdlog/spdlog.h>
 
@@ -18,7 +27,10 @@ static constexpr auto USAGE =
     R"(Solve problem
 
     Usage:
-          solve --exhaustive --dimacs=FILE
+          solve --exhaustive --dimacs=FILE [--all-solutions | --count]
+          solve --exhaustive --dimacs=FILE --components [--threads=N] [--count]
+          solve --exhaustive --fd=FILE [--all-solutions | --count]
+          solve --local-search --dimacs=FILE [--max-flips=N] [--seed=S]
           solve (-h | --help)
           solve --version
     Options:
@@ -27,8 +39,247 @@ static constexpr auto USAGE =
           --exhaustive    Use exhaustive-search strategy, which traverses all
                           dom_size ** num_variables search space.
           --dimacs=fILE   DIMACS formatted CNF file.
+          --fd=FILE       Finite-domain problem file, with alldiff and linear constraints.
+          --all-solutions Print every solution, as a 'v' line each.
+          --count         Print the number of solutions, as 's mc <count>'. CNF formulas are always
+                          split into components for counting, and their counts multiplied.
+          --components    Split the formula into variable-disjoint components, and solve them
+                          independently of each other.
+          --threads=N     Number of threads that solve components, 0 for one per core [default: 0].
+          --local-search  Use stochastic local search (ProbSAT), which finds models but can not
+                          prove unsatisfiability.
+          --max-flips=N   Give up with 's UNKNOWN' after N flips [default: 100000000].
+          --seed=S        Seed of the local search [default: 1].
 )";
 
+namespace {
+enum class solve_mode { first_solution, all_solutions, count };
+
+template<typename solver_t, typename print_solution_t>
+void run_solver(solver_t &solver, solve_mode mode, const print_solution_t &print_solution)
+{
+    switch (mode) {
+    case solve_mode::first_solution:
+        if (solver.solve()) {
+            fmt::print("s SATISFIABLE\n");
+            print_solution(solver);
+        } else {
+            fmt::print("s UNSATISFIABLE\n");
+        }
+        break;
+    case solve_mode::all_solutions: {
+        const size_t solutions = solver.for_each_solution([&] {
+            print_solution(solver);
+            return true;
+        });
+        fmt::print("c solutions {}\n", solutions);
+        fmt::print("s {}\n", solutions != 0 ? "SATISFIABLE" : "UNSATISFIABLE");
+        break;
+    }
+    case solve_mode::count:
+        fmt::print("s mc {}\n", solver.count_solutions().to_string());
+        break;
+    }
+}
+
+struct fd_problem
+{
+    unsigned variables = 0;
+    unsigned values = 0;
+    std::vector<std::pair<unsigned, unsigned>> domains;
+    std::vector<std::vector<unsigned>> all_different_constraints;
+    std::vector<std::pair<std::vector<solver::linear_term>, std::int64_t>> linear_constraints;
+};
+
+using dimacs_domain_t = solver::boolean_domain;
+
+void print_specialization(const solver::instance_profile &profile)
+{
+    const solver::specialization selected =
+        solver::select_specialization(profile, solver::compiled_specializations);
+    fmt::print("c specialization {}-bit index{}\n", selected.index_bits, selected.huge_pages ? ", huge pages" : "");
+}
+
+template<typename value_of_t> void print_dimacs_model(size_t variables, const value_of_t &value_of)
+{
+    fmt::print("v ");
+    for (unsigned i = 0; i != variables; ++i) {
+        if (value_of(i)) {
+            fmt::print("{} ", i + 1);
+        } else {
+            fmt::print("-{} ", i + 1);
+        }
+    }
+    fmt::print("0\n");
+}
+
+int solve_dimacs_components(std::istream &dimacs_stream, solve_mode mode, unsigned threads)
+{
+    unsigned variables = 0;
+    std::vector<std::vector<int>> clauses;
+    auto constructor = [&](unsigned read_variables, unsigned read_clauses) {
+        variables = read_variables;
+        clauses.reserve(read_clauses);
+    };
+    auto add_clause = [&](const std::vector<int> &literals) { clauses.push_back(literals); };
+    solver::parse_dimacs(dimacs_stream, constructor, add_clause);
+
+    const std::vector<solver::cnf_component> components = solver::split_components(variables, clauses);
+    fmt::print("c components {}\n", components.size());
+    // All the components share one specialization, the one that fits the largest of them.
+    solver::instance_profile profile;
+    for (const solver::cnf_component &component : components) {
+        profile.variables = std::max(profile.variables, component.variables.size());
+    }
+    print_specialization(profile);
+    return solver::dispatch_dimacs_solver(profile, [&]<typename solver_t>(std::type_identity<solver_t>) {
+        const dimacs_domain_t unset = { false, true };
+        if (mode == solve_mode::count) {
+            fmt::print("s mc {}\n", solver::count_components<solver_t>(components, unset, threads).to_string());
+            return 0;
+        }
+        const std::optional<std::vector<bool>> model =
+            solver::solve_components<solver_t>(variables, components, unset, threads);
+        if (model) {
+            fmt::print("s SATISFIABLE\n");
+            print_dimacs_model(model->size(), [&model](unsigned i) { return (*model)[i]; });
+        } else {
+            fmt::print("s UNSATISFIABLE\n");
+        }
+        return 0;
+    });
+}
+
+int solve_dimacs(std::istream &dimacs_stream, solve_mode mode)
+{
+    // The clauses are buffered, since the solver type depends on the header and the clauses follow it.
+    std::optional<unsigned> variables;
+    std::vector<std::vector<int>> clauses;
+    auto constructor = [&](unsigned read_variables, unsigned read_clauses) {
+        variables = read_variables;
+        clauses.reserve(read_clauses);
+    };
+    auto add_clause = [&](const std::vector<int> &literals) { clauses.push_back(literals); };
+    solver::parse_dimacs(dimacs_stream, constructor, add_clause);
+    if (!variables) {
+        fmt::print("s UNKNOWN\n");
+        return 1;
+    }
+    const solver::instance_profile profile{ *variables };
+    print_specialization(profile);
+    return solver::dispatch_dimacs_solver(profile, [&]<typename solver_t>(std::type_identity<solver_t>) {
+        solver_t cnf_solver(*variables, dimacs_domain_t{ false, true });
+        for (const std::vector<int> &clause : clauses) { cnf_solver.add_clause(clause); }
+        run_solver(cnf_solver, mode, [](const solver_t &solver) {
+            print_dimacs_model(solver.num_variables(), [&solver](unsigned i) { return solver.get_value(i); });
+        });
+        return 0;
+    });
+}
+
+int solve_dimacs_local_search(std::istream &dimacs_stream, std::uint64_t max_flips, std::uint64_t seed)
+{
+    std::unique_ptr<solver::local_search_solver> solver_ptr;
+    auto constructor = [&](unsigned variables, unsigned constraints) {
+        std::ignore = constraints;
+        solver_ptr = std::make_unique<solver::local_search_solver>(variables, seed);
+    };
+    auto add_clause = [&](const std::vector<int> &literals) { solver_ptr->add_clause(literals); };
+    solver::parse_dimacs(dimacs_stream, constructor, add_clause);
+    if (!solver_ptr) {
+        fmt::print("s UNKNOWN\n");
+        return 1;
+    }
+    const solver::local_search_result result = solver_ptr->solve(max_flips);
+    fmt::print("c flips {}\n", solver_ptr->flips());
+    switch (result) {
+    case solver::local_search_result::satisfiable:
+        fmt::print("s SATISFIABLE\n");
+        print_dimacs_model(solver_ptr->num_variables(), [&](unsigned i) { return solver_ptr->get_value(i); });
+        break;
+    case solver::local_search_result::unsatisfiable:
+        fmt::print("s UNSATISFIABLE\n");
+        break;
+    case solver::local_search_result::unknown:
+        fmt::print("s UNKNOWN\n");
+        break;
+    }
+    return 0;
+}
+
+template<unsigned max_values, typename index_t> int solve_fd(const fd_problem &problem, solve_mode mode)
+{
+    using domain_t = solver::bitset_domain<max_values>;
+    using state_t = solver::trail_constraint_state<domain_t, index_t>;
+    using solver_t = solver::exhaustive_solver<state_t, solver::fd_constraint<state_t>>;
+    solver_t fd_solver(problem.variables, domain_t::range(0, static_cast<int>(problem.values) - 1));
+    for (unsigned i = 0; i != problem.variables; ++i) {
+        fd_solver.set_domain(i,
+            domain_t::range(static_cast<int>(problem.domains[i].first), static_cast<int>(problem.domains[i].second)));
+    }
+    auto to_parameters = [](const auto &variables) {
+        std::vector<typename state_t::parameter_t> parameters;
+        parameters.reserve(variables.size());
+        for (unsigned variable : variables) { parameters.push_back(solver_t::to_parameter(variable)); }
+        return parameters;
+    };
+    for (const std::vector<unsigned> &variables : problem.all_different_constraints) {
+        fd_solver.add_constraint(solver::all_different<state_t>(to_parameters(variables)));
+    }
+    for (const auto &[terms, bound] : problem.linear_constraints) {
+        std::vector<unsigned> variables;
+        std::vector<int> coefficients;
+        for (const solver::linear_term &term : terms) {
+            variables.push_back(term.variable);
+            coefficients.push_back(term.coefficient);
+        }
+        fd_solver.add_constraint(solver::linear_inequality<state_t>(to_parameters(variables), coefficients, bound));
+    }
+    run_solver(fd_solver, mode, [](const solver_t &solver) {
+        fmt::print("v");
+        for (unsigned i = 0; i != solver.num_variables(); ++i) { fmt::print(" {}", solver.get_value(i)); }
+        fmt::print("\n");
+    });
+    return 0;
+}
+
+int solve_fd(std::istream &fd_stream, solve_mode mode)
+{
+    fd_problem problem;
+    auto constructor = [&](unsigned variables, unsigned values) {
+        problem.variables = variables;
+        problem.values = values;
+        problem.domains.assign(variables, { 0, values - 1 });
+    };
+    auto restrict_domain = [&](unsigned variable, unsigned min_value, unsigned max_value) {
+        problem.domains[variable] = { min_value, max_value };
+    };
+    auto add_all_different = [&](const std::vector<unsigned> &variables) {
+        problem.all_different_constraints.push_back(variables);
+    };
+    auto add_linear = [&](const std::vector<solver::linear_term> &terms, std::int64_t bound) {
+        problem.linear_constraints.emplace_back(terms, bound);
+    };
+    solver::parse_fd(fd_stream, constructor, restrict_domain, add_all_different, add_linear);
+    if (problem.values > 256) {
+        throw std::runtime_error(fmt::format("Up to 256 values are supported, but got {}", problem.values));
+    }
+    // Finite-domain states are not laid out for huge pages, only the index width is specialized.
+    fmt::print("c specialization {}-bit index\n",
+        solver::select_specialization(solver::instance_profile{ problem.variables }, solver::compiled_specializations)
+            .index_bits);
+    return solver::dispatch_index_type(problem.variables, [&]<typename index_t>(std::type_identity<index_t>) {
+        if (problem.values <= 64) {
+            return solve_fd<64, index_t>(problem, mode);
+        }
+        if (problem.values <= 128) {
+            return solve_fd<128, index_t>(problem, mode);
+        }
+        return solve_fd<256, index_t>(problem, mode);
+    });
+}
+}// namespace
+
 int main(int argc, const char **argv)
 {
     try {
@@ -39,43 +290,34 @@ int main(int argc, const char **argv)
                 myproject::cmake::project_name,
                 myproject::cmake::project_version));// version string, acquired from config.hpp via CMake
 
-
-        fmt::print("c solving {}\n", args.at("--dimacs").asString());
-        std::ifstream dimacs_stream{ args.at("--dimacs").asString() };
-        if (!dimacs_stream) {
-            fmt::print(
-                "c Could not open file {}\n", args.at("--dimacs").asString(), std::filesystem::current_path().string());
+        const bool is_fd = static_cast<bool>(args.at("--fd"));
+        const std::string file_name = args.at(is_fd ? "--fd" : "--dimacs").asString();
+        fmt::print("c solving {}\n", file_name);
+        std::ifstream input_stream{ file_name };
+        if (!input_stream) {
+            fmt::print("c Could not open file {}\n", file_name, std::filesystem::current_path().string());
             fmt::print("s UNKNOWN\n");
             return 1;
         }
-        using domain_t = std::set<bool>;
-        domain_t unset = { false, true };
-        using solver_t = solver::exhaustive_solver<solver::uniform_constraint_state<domain_t, std::uint8_t>>;
-        std::unique_ptr<solver_t> solver_ptr;
-        auto constructor = [&](unsigned variables, unsigned constraints) {
-            std::ignore = constraints;
-            solver_ptr = std::make_unique<solver_t>(variables, unset);
-        };
-        auto add_clause = [&](const std::vector<int> &literals) { solver_ptr->add_clause(literals); };
-        solver::parse_dimacs(dimacs_stream, constructor, add_clause);
-        if (!solver_ptr) {
-            fmt::print("s UNKNOWN\n");
-            return 1;
+        solve_mode mode = solve_mode::first_solution;
+        if (args.at("--all-solutions").asBool()) {
+            mode = solve_mode::all_solutions;
+        } else if (args.at("--count").asBool()) {
+            mode = solve_mode::count;
         }
-        if (solver_ptr->solve()) {
-            fmt::print("s SATISFIABLE\n");
-            fmt::print("v ");
-            for (unsigned i = 0; i != solver_ptr->num_variables(); ++i) {
-                if (solver_ptr->get_value(i)) {
-                    fmt::print("{} ", i + 1);
-                } else {
-                    fmt::print("-{} ", i + 1);
-                }
-            }
-            fmt::print("0\n");
-        } else {
-            fmt::print("s UNSATISFIABLE\n");
+        if (is_fd) {
+            return solve_fd(input_stream, mode);
+        }
+        if (args.at("--local-search").asBool()) {
+            return solve_dimacs_local_search(input_stream,
+                solver::parse_number_option<std::uint64_t>(args, "--max-flips"),
+                solver::parse_number_option<std::uint64_t>(args, "--seed"));
+        }
+        if (args.at("--components").asBool() || mode == solve_mode::count) {
+            return solve_dimacs_components(
+                input_stream, mode, solver::parse_number_option<unsigned>(args, "--threads"));
         }
+        return solve_dimacs(input_stream, mode);
     } catch (const std::exception &e) {
         fmt::print("c Unhandled exception in main: {}\n", e.what());
         fmt::print("s UNKNOWN\n");
@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solver {
+
+/**
+ * An arbitrary-precision unsigned counter, for model counts that do not fit in 64 bits.
+ * Only the operations that counting needs are supported: increment, addition, multiplication, and
+ * conversion to a decimal string.
+ */
+class model_count
+{
+  public:
+    using limb_t = std::uint32_t;
+
+    model_count() = default;
+    explicit model_count(std::uint64_t value)
+    {
+        for (; value != 0; value >>= limb_bits) { m_limbs.push_back(static_cast<limb_t>(value)); }
+    }
+
+    model_count &operator++()
+    {
+        for (limb_t &limb : m_limbs) {
+            if (++limb != 0) {
+                return *this;
+            }
+        }
+        m_limbs.push_back(1);
+        return *this;
+    }
+    model_count &operator+=(const model_count &other)
+    {
+        if (m_limbs.size() < other.m_limbs.size()) {
+            m_limbs.resize(other.m_limbs.size(), 0);
+        }
+        std::uint64_t carry = 0;
+        for (size_t i = 0; i != m_limbs.size(); ++i) {
+            carry += m_limbs[i];
+            if (i < other.m_limbs.size()) {
+                carry += other.m_limbs[i];
+            } else if (carry <= max_limb) {
+                m_limbs[i] = static_cast<limb_t>(carry);
+                return *this;
+            }
+            m_limbs[i] = static_cast<limb_t>(carry);
+            carry >>= limb_bits;
+        }
+        if (carry != 0) {
+            m_limbs.push_back(static_cast<limb_t>(carry));
+        }
+        return *this;
+    }
+    model_count &operator*=(limb_t factor)
+    {
+        if (factor == 0) {
+            m_limbs.clear();
+            return *this;
+        }
+        std::uint64_t carry = 0;
+        for (limb_t &limb : m_limbs) {
+            carry += static_cast<std::uint64_t>(limb) * factor;
+            limb = static_cast<limb_t>(carry);
+            carry >>= limb_bits;
+        }
+        if (carry != 0) {
+            m_limbs.push_back(static_cast<limb_t>(carry));
+        }
+        return *this;
+    }
+    model_count &operator*=(const model_count &other)
+    {
+        std::vector<limb_t> product(m_limbs.size() + other.m_limbs.size(), 0);
+        for (size_t i = 0; i != m_limbs.size(); ++i) {
+            std::uint64_t carry = 0;
+            for (size_t j = 0; j != other.m_limbs.size(); ++j) {
+                carry += static_cast<std::uint64_t>(m_limbs[i]) * other.m_limbs[j] + product[i + j];
+                product[i + j] = static_cast<limb_t>(carry);
+                carry >>= limb_bits;
+            }
+            product[i + other.m_limbs.size()] = static_cast<limb_t>(carry);
+        }
+        while (!product.empty() && product.back() == 0) { product.pop_back(); }
+        m_limbs = std::move(product);
+        return *this;
+    }
+    friend model_count operator+(model_count lhs, const model_count &rhs) { return lhs += rhs; }
+    friend model_count operator*(model_count lhs, limb_t rhs) { return lhs *= rhs; }
+    friend bool operator==(const model_count &, const model_count &) = default;
+
+    bool is_zero() const { return m_limbs.empty(); }
+
+    std::string to_string() const
+    {
+        if (m_limbs.empty()) {
+            return "0";
+        }
+        std::vector<limb_t> quotient = m_limbs;
+        std::string digits;
+        while (!quotient.empty()) {
+            // Divide by 10^9 to peel off nine decimal digits per pass.
+            std::uint64_t remainder = 0;
+            for (size_t i = quotient.size(); i-- != 0;) {
+                const std::uint64_t current = (remainder << limb_bits) | quotient[i];
+                quotient[i] = static_cast<limb_t>(current / digits_divisor);
+                remainder = current % digits_divisor;
+            }
+            while (!quotient.empty() && quotient.back() == 0) { quotient.pop_back(); }
+            for (unsigned digit = 0; digit != digits_per_pass && (remainder != 0 || !quotient.empty()); ++digit) {
+                digits.push_back(static_cast<char>('0' + remainder % 10));
+                remainder /= 10;
+            }
+        }
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+
+  private:
+    static constexpr unsigned limb_bits = 32;
+    static constexpr std::uint64_t max_limb = 0xffffffffU;
+    static constexpr std::uint64_t digits_divisor = 1'000'000'000U;
+    static constexpr unsigned digits_per_pass = 9;
+
+    // Little-endian, without leading zero limbs, so that zero is an empty vector.
+    std::vector<limb_t> m_limbs;
+};
+
+}// namespace solver
@@ -0,0 +1,54 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solver {
+
+/**
+ * Calls task(i) for every i in 0..count-1 on up to 'threads' worker threads, where 0 means one per core.
+ * Workers pick the next index from a shared counter, so long tasks do not hold up the short ones.
+ * The first exception thrown by a task is rethrown once all workers are done.
+ */
+template<typename task_t> void parallel_for(size_t count, unsigned threads, const task_t &task)
+{
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+    if (threads <= 1) {
+        for (size_t i = 0; i != count; ++i) { task(i); }
+        return;
+    }
+
+    std::atomic<size_t> next_index{ 0 };
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threads);
+        for (unsigned thread = 0; thread != threads; ++thread) {
+            workers.emplace_back([&] {
+                for (size_t i = next_index++; i < count; i = next_index++) {
+                    try {
+                        task(i);
+                    } catch (...) {
+                        const std::lock_guard lock(error_mutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+            });
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}// namespace solver
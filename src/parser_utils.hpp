@@ -0,0 +1,12 @@
+#pragma once
+#include <algorithm>
+#include <string_view>
+
+namespace solver {
+
+inline std::string_view lstrip(std::string_view view)
+{
+    view.remove_prefix(std::min(view.find_first_not_of("\t "), view.size()));
+    return view;
+}
+}// namespace solver
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+namespace solver {
+
+/**
+ * A small deterministic random source (splitmix64), so that a seed produces the same results with
+ * every compiler and standard library.
+ */
+class random_source
+{
+  public:
+    explicit random_source(std::uint64_t seed) : m_state(seed) {}
+    std::uint64_t next()
+    {
+        std::uint64_t result = (m_state += 0x9e3779b97f4a7c15U);
+        result = (result ^ (result >> 30U)) * 0xbf58476d1ce4e5b9U;
+        result = (result ^ (result >> 27U)) * 0x94d049bb133111ebU;
+        return result ^ (result >> 31U);
+    }
+    /// Uniform in 0..bound-1, bound must be positive.
+    std::uint64_t below(std::uint64_t bound)
+    {
+        // Reject the top partial range, so that every remainder is equally likely.
+        const std::uint64_t threshold = (0 - bound) % bound;
+        while (true) {
+            const std::uint64_t value = next();
+            if (value >= threshold) {
+                return value % bound;
+            }
+        }
+    }
+    /// Uniform in [0, 1).
+    double uniform()
+    {
+        constexpr double scale = 1.0 / static_cast<double>(std::uint64_t{ 1 } << 53U);
+        return static_cast<double>(next() >> 11U) * scale;
+    }
+    bool coin() { return (next() & 1U) != 0; }
+
+  private:
+    std::uint64_t m_state;
+};
+
+}// namespace solver
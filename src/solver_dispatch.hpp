@@ -0,0 +1,111 @@
+#pragma once
+#include "aligned_allocator.hpp"
+#include "exhaustive_solver.hpp"
+#include "literal_state.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// The build selects which specializations get compiled, to bound the binary size. The 32-bit index is always
+// compiled, since it is the fallback that fits every instance.
+#ifndef SOLVER_DISPATCH_INDEX8
+#define SOLVER_DISPATCH_INDEX8 1
+#endif
+#ifndef SOLVER_DISPATCH_INDEX16
+#define SOLVER_DISPATCH_INDEX16 1
+#endif
+#ifndef SOLVER_DISPATCH_HUGE_PAGES
+#define SOLVER_DISPATCH_HUGE_PAGES 1
+#endif
+
+namespace solver {
+
+/// The optional specializations that the dispatcher may choose from.
+struct specialization_set
+{
+    bool index8 = true;
+    bool index16 = true;
+    bool huge_pages = true;
+};
+
+inline constexpr specialization_set compiled_specializations{ SOLVER_DISPATCH_INDEX8 != 0,
+    SOLVER_DISPATCH_INDEX16 != 0,
+    SOLVER_DISPATCH_HUGE_PAGES != 0 };
+
+/// What is known about an instance before it is solved.
+struct instance_profile
+{
+    size_t variables = 0;
+};
+
+struct specialization
+{
+    unsigned index_bits = 32;
+    bool huge_pages = false;
+    friend bool operator==(const specialization &, const specialization &) = default;
+};
+
+/// The literal array reaches a huge page at this many variables, two bytes per variable.
+inline constexpr size_t huge_page_min_variables = huge_page_size / 2;
+
+/**
+ * Picks the narrowest enabled variable index that fits the instance, so that parameters and trail entries
+ * are as small as possible, and huge pages once the literal array is big enough to benefit from them.
+ */
+constexpr specialization select_specialization(const instance_profile &profile, const specialization_set &enabled)
+{
+    auto fits = [&profile]<typename index_t>(std::type_identity<index_t>) {
+        return profile.variables == 0 || profile.variables - 1 <= std::numeric_limits<index_t>::max();
+    };
+    specialization selected;
+    if (enabled.index8 && fits(std::type_identity<std::uint8_t>{})) {
+        selected.index_bits = 8;
+    } else if (enabled.index16 && fits(std::type_identity<std::uint16_t>{})) {
+        selected.index_bits = 16;
+    }
+    selected.huge_pages = enabled.huge_pages && profile.variables >= huge_page_min_variables;
+    return selected;
+}
+
+/**
+ * Calls callback(std::type_identity<index_t>{}) with the variable index type that select_specialization()
+ * picks for the given number of variables. Only the enabled index types are instantiated.
+ */
+template<specialization_set enabled = compiled_specializations, typename callback_t>
+decltype(auto) dispatch_index_type(size_t variables, callback_t &&callback)
+{
+    const specialization selected = select_specialization(instance_profile{ variables }, enabled);
+    if constexpr (enabled.index8) {
+        if (selected.index_bits == 8) {
+            return std::forward<callback_t>(callback)(std::type_identity<std::uint8_t>{});
+        }
+    }
+    if constexpr (enabled.index16) {
+        if (selected.index_bits == 16) {
+            return std::forward<callback_t>(callback)(std::type_identity<std::uint16_t>{});
+        }
+    }
+    return std::forward<callback_t>(callback)(std::type_identity<std::uint32_t>{});
+}
+
+/**
+ * Calls callback(std::type_identity<solver_t>{}) with the exhaustive CNF solver specialized for the instance,
+ * so that the whole search is compiled for the chosen index width and memory layout.
+ */
+template<specialization_set enabled = compiled_specializations, typename callback_t>
+decltype(auto) dispatch_dimacs_solver(const instance_profile &profile, callback_t &&callback)
+{
+    return dispatch_index_type<enabled>(profile.variables, [&]<typename index_t>(std::type_identity<index_t>) {
+        if constexpr (enabled.huge_pages) {
+            if (select_specialization(profile, enabled).huge_pages) {
+                return std::forward<callback_t>(callback)(
+                    std::type_identity<exhaustive_solver<literal_state<index_t, true>>>{});
+            }
+        }
+        return std::forward<callback_t>(callback)(std::type_identity<exhaustive_solver<literal_state<index_t>>>{});
+    });
+}
+
+}// namespace solver
@@ -0,0 +1,141 @@
+#pragma once
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+namespace solver {
+
+/**
+ * A constraint state that records every domain change on an undo trail.
+ * new_level() opens a decision level and backtrack() undoes all the changes made since the matching
+ * new_level(), however many of them were made by propagation, by truncating the trail.
+ * Changes made while no level is open are permanent, and are not recorded.
+ *
+ * The trail holds one entry per value that was removed from (or added to) a domain, and domains are changed in
+ * place, so that allocating domains such as std::set are never copied by the trail.
+ */
+template<typename Domain, std::integral VariableIndexType> class trail_constraint_state
+{
+  public:
+    using domain_type = Domain;
+    using value_type = typename domain_type::value_type;
+    using param_index_t = VariableIndexType;
+    struct parameter_t
+    {
+        VariableIndexType variable_index;
+    };
+    explicit trail_constraint_state(unsigned variables, const domain_type &domain) : m_variables(variables, domain)
+    {
+        // Trail entries are reused after backtracking, so once the search reaches its typical depth
+        // no further allocations happen in the trail.
+        m_trail.reserve(variables * 2U);
+        m_level_starts.reserve(variables + 1U);
+    }
+    const domain_type &get_domain(parameter_t param) const { return m_variables[param.variable_index]; }
+    value_type get_value(parameter_t param) const
+    {
+        const domain_type &domain = get_domain(param);
+        assert(domain.size() == 1);
+        return *domain.begin();
+    }
+    void set_domain(parameter_t param, const domain_type &dom)
+    {
+        domain_type &current = m_variables[param.variable_index];
+        if (m_level_starts.empty()) {
+            current = dom;
+            return;
+        }
+        const size_t first_change = m_trail.size();
+        for (const value_type &value : current) {
+            if (dom.count(value) == 0) {
+                m_trail.push_back({ param.variable_index, value, true });
+            }
+        }
+        for (const value_type &value : dom) {
+            if (current.count(value) == 0) {
+                m_trail.push_back({ param.variable_index, value, false });
+            }
+        }
+        apply_from(first_change);
+    }
+    void set_value(parameter_t param, value_type value)
+    {
+        domain_type &current = m_variables[param.variable_index];
+        if (m_level_starts.empty()) {
+            current.clear();
+            current.insert(value);
+            return;
+        }
+        const size_t first_change = m_trail.size();
+        for (const value_type &old_value : current) {
+            if (old_value != value) {
+                m_trail.push_back({ param.variable_index, old_value, true });
+            }
+        }
+        if (current.count(value) == 0) {
+            m_trail.push_back({ param.variable_index, value, false });
+        }
+        apply_from(first_change);
+    }
+    /// Removes a single value, without building a new domain.
+    void remove_value(parameter_t param, value_type value)
+    {
+        domain_type &current = m_variables[param.variable_index];
+        if (current.count(value) == 0) {
+            return;
+        }
+        if (!m_level_starts.empty()) {
+            m_trail.push_back({ param.variable_index, value, true });
+        }
+        current.erase(value);
+    }
+    size_t size() const { return m_variables.size(); }
+
+    void new_level() { m_level_starts.push_back(m_trail.size()); }
+    void backtrack()
+    {
+        assert(!m_level_starts.empty());
+        const size_t level_start = m_level_starts.back();
+        m_level_starts.pop_back();
+        while (m_trail.size() != level_start) {
+            const trail_entry &entry = m_trail.back();
+            if (entry.removed) {
+                m_variables[entry.variable_index].insert(entry.value);
+            } else {
+                m_variables[entry.variable_index].erase(entry.value);
+            }
+            m_trail.pop_back();
+        }
+    }
+    size_t level() const { return m_level_starts.size(); }
+    /// Grows with every recorded change, can be compared to detect whether propagation changed anything.
+    size_t trail_size() const { return m_trail.size(); }
+
+  private:
+    struct trail_entry
+    {
+        param_index_t variable_index;
+        value_type value;
+        bool removed;
+    };
+
+    // Values are collected before any of them is changed, since the domain is iterated while collecting.
+    void apply_from(size_t first_change)
+    {
+        for (size_t i = first_change; i != m_trail.size(); ++i) {
+            const trail_entry &entry = m_trail[i];
+            if (entry.removed) {
+                m_variables[entry.variable_index].erase(entry.value);
+            } else {
+                m_variables[entry.variable_index].insert(entry.value);
+            }
+        }
+    }
+
+    std::vector<domain_type> m_variables;
+    std::vector<trail_entry> m_trail;
+    std::vector<size_t> m_level_starts;
+};
+
+}// namespace solver
@@ -1,6 +1,11 @@
 #include <catch2/catch.hpp>
 
+#include "../src/all_different.hpp"
 #include "../src/binary_clause.hpp"
+#include "../src/bitset_domain.hpp"
+#include "../src/exhaustive_solver.hpp"
+#include "../src/linear_inequality.hpp"
+#include "../src/literal_state.hpp"
 #include "test_constraints.hpp"
 
 using namespace solver::test;
@@ -14,3 +19,33 @@ TEST_CASE("concepts", "[parameters]")
     STATIC_REQUIRE(solver::constraint<solver::binary_clause<test_constraint_state<true>>>);
     STATIC_REQUIRE(solver::constraint_state<test_constraint_state<true>>);
 }
+
+TEST_CASE("propagating concepts", "[parameters]")
+{
+    using fd_state = solver::uniform_constraint_state<solver::bitset_domain<64>, std::uint8_t>;
+    STATIC_REQUIRE(solver::propagating_constraint<solver::binary_clause<test_constraint_state<true>>>);
+    STATIC_REQUIRE(solver::propagating_constraint<solver::binary_clause<test_constraint_state<false>>>);
+    STATIC_REQUIRE(solver::constraint_state<fd_state>);
+    STATIC_REQUIRE(solver::integral_domain<fd_state>);
+    STATIC_REQUIRE(solver::propagating_constraint<solver::all_different<fd_state>>);
+    STATIC_REQUIRE(solver::propagating_constraint<solver::linear_inequality<fd_state>>);
+}
+
+TEST_CASE("backtrackable concepts", "[parameters]")
+{
+    using trail_state = solver::trail_constraint_state<std::set<bool>, std::uint8_t>;
+    using uniform_state = solver::uniform_constraint_state<std::set<bool>, std::uint8_t>;
+    STATIC_REQUIRE(solver::backtrackable_constraint_state<solver::literal_state<std::uint8_t>>);
+    STATIC_REQUIRE(solver::backtrackable_constraint_state<solver::literal_state<std::uint32_t, true>>);
+    STATIC_REQUIRE(solver::bool_domain<solver::literal_state<std::uint8_t>>);
+    STATIC_REQUIRE(solver::backtrackable_constraint_state<trail_state>);
+    STATIC_REQUIRE(!solver::backtrackable_constraint_state<uniform_state>);
+    STATIC_REQUIRE(solver::constraint<solver::binary_clause<solver::literal_state<std::uint8_t>>>);
+}
+
+TEST_CASE("bitset_domain constexpr", "[bitset_domain]")
+{
+    STATIC_REQUIRE(solver::bitset_domain<64>::range(3, 10).size() == 8);
+    STATIC_REQUIRE(solver::bitset_domain<128>{ 5, 100 }.max() == 100);
+    STATIC_REQUIRE(solver::bitset_domain<128>{ 5, 100 }.min() == 5);
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+#include <vector>
+
+#include "../src/bitset_domain.hpp"
+#include "../src/constraint.hpp"
+
+using solver::bitset_domain;
+
+TEST_CASE("empty", "[bitset_domain]")
+{
+    const bitset_domain<64> domain;
+    CHECK(domain.empty());
+    CHECK(domain.size() == 0);
+    CHECK(domain.begin() == domain.end());
+    CHECK(domain.count(0) == 0);
+    CHECK(domain.count(-1) == 0);
+    CHECK(domain.count(64) == 0);
+}
+
+TEST_CASE("insert erase", "[bitset_domain]")
+{
+    bitset_domain<128> domain{ 3, 64, 127 };
+    CHECK(domain.size() == 3);
+    CHECK(domain.count(64) == 1);
+    CHECK(domain.erase(64) == 1);
+    CHECK(domain.erase(64) == 0);
+    CHECK(domain.count(64) == 0);
+    CHECK(domain.size() == 2);
+    domain.insert(0);
+    CHECK(std::vector<int>(domain.begin(), domain.end()) == std::vector<int>{ 0, 3, 127 });
+    domain.clear();
+    CHECK(domain.empty());
+}
+
+TEST_CASE("iterate across words", "[bitset_domain]")
+{
+    const bitset_domain<256> domain{ 255, 63, 64, 128, 1 };
+    CHECK(std::vector<int>(domain.begin(), domain.end()) == std::vector<int>{ 1, 63, 64, 128, 255 });
+    CHECK(domain.min() == 1);
+    CHECK(domain.max() == 255);
+}
+
+TEST_CASE("range", "[bitset_domain]")
+{
+    const auto domain = bitset_domain<128>::range(60, 70);
+    CHECK(domain.size() == 11);
+    CHECK(domain.min() == 60);
+    CHECK(domain.max() == 70);
+    CHECK(domain.count(59) == 0);
+    CHECK(domain.count(71) == 0);
+}
+
+TEST_CASE("set operations", "[bitset_domain]")
+{
+    const auto low = bitset_domain<256>::range(0, 130);
+    const auto high = bitset_domain<256>::range(120, 200);
+    CHECK((low & high) == bitset_domain<256>::range(120, 130));
+    CHECK((low | high) == bitset_domain<256>::range(0, 200));
+    CHECK(solver::domain_min(high) == 120);
+    CHECK(solver::domain_max(low) == 130);
+}
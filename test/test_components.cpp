@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "../src/component_solver.hpp"
+#include "../src/components.hpp"
+#include "../src/exhaustive_solver.hpp"
+
+using solver::cnf_component;
+
+namespace {
+using domain_t = std::set<bool>;
+using solver_t = solver::exhaustive_solver<solver::uniform_constraint_state<domain_t, std::uint8_t>>;
+const domain_t unset{ false, true };
+}// namespace
+
+TEST_CASE("union_find", "[components]")
+{
+    solver::union_find sets(5);
+    sets.unite(0, 3);
+    sets.unite(4, 3);
+    CHECK(sets.find(0) == sets.find(4));
+    CHECK(sets.find(1) != sets.find(0));
+    CHECK(sets.find(1) != sets.find(2));
+    sets.unite(1, 2);
+    sets.unite(2, 0);
+    CHECK(sets.find(1) == sets.find(4));
+}
+
+TEST_CASE("split_components", "[components]")
+{
+    const std::vector<cnf_component> components =
+        solver::split_components(6, { { 1, -4 }, { 2, 6 }, { -6, 2 }, {}, { 4 } });
+    REQUIRE(components.size() == 4);
+    CHECK(components[0].variables == std::vector<unsigned>{ 0, 3 });
+    CHECK(components[0].clauses == std::vector<std::vector<int>>{ { 1, -2 }, { 2 } });
+    CHECK(components[1].variables == std::vector<unsigned>{ 1, 5 });
+    CHECK(components[1].clauses == std::vector<std::vector<int>>{ { 1, 2 }, { -2, 1 } });
+    CHECK(components[2].variables == std::vector<unsigned>{ 2, 4 });
+    CHECK(components[2].clauses.empty());
+    CHECK(components[3].variables.empty());
+    CHECK(components[3].clauses == std::vector<std::vector<int>>{ {} });
+
+    REQUIRE_THROWS_AS(solver::split_components(2, { { 1, 3 } }), std::out_of_range);
+}
+
+TEST_CASE("solve_components", "[components]")
+{
+    const std::vector<std::vector<int>> clauses{ { 1, 2 }, { -1, -2 }, { 3, -4 }, { -3, 4 }, { 4 } };
+    const std::vector<cnf_component> components = solver::split_components(5, clauses);
+    const auto model = solver::solve_components<solver_t>(5, components, unset, 2);
+    REQUIRE(model);
+    CHECK(*model == std::vector<bool>{ false, true, true, true, false });
+    CHECK(solver::count_components<solver_t>(components, unset, 2) == solver::model_count(4));
+
+    const std::vector<cnf_component> unsat_components = solver::split_components(3, { { 1 }, { -1 }, { 2, 3 } });
+    CHECK(!solver::solve_components<solver_t>(3, unsat_components, unset, 2));
+    CHECK(solver::count_components<solver_t>(unsat_components, unset, 2).is_zero());
+}
+
+TEST_CASE("components lift the solver's variable limit", "[components]")
+{
+    std::vector<std::vector<int>> clauses;
+    for (int variable = 1; variable < 600; variable += 2) { clauses.push_back({ variable, -(variable + 1) }); }
+    REQUIRE_THROWS_AS(solver_t(600, unset), std::out_of_range);
+    const std::vector<cnf_component> components = solver::split_components(600, clauses);
+    CHECK(components.size() == 300);
+    const auto model = solver::solve_components<solver_t>(600, components, unset, 0);
+    REQUIRE(model);
+    CHECK(model->size() == 600);
+    // 3^300
+    solver::model_count expected(1);
+    for (unsigned i = 0; i != 300; ++i) { expected *= 3; }
+    CHECK(solver::count_components<solver_t>(components, unset, 0) == expected);
+}
+
+TEST_CASE("parallel_for", "[components]")
+{
+    std::vector<unsigned> visits(1000, 0);
+    solver::parallel_for(visits.size(), 4, [&visits](size_t index) { visits[index] += static_cast<unsigned>(index); });
+    for (size_t i = 0; i != visits.size(); ++i) { REQUIRE(visits[i] == i); }
+    REQUIRE_THROWS_AS(solver::parallel_for(10, 4,
+                          [](size_t index) {
+                              if (index == 7) {
+                                  throw std::runtime_error("task failed");
+                              }
+                          }),
+        std::runtime_error);
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "../src/bitset_domain.hpp"
+#include "../src/exhaustive_solver.hpp"
+#include "../src/fd_constraint.hpp"
+#include "../src/literal_state.hpp"
+#include "../src/random_source.hpp"
+
+namespace {
+using bool_domain_t = std::set<bool>;
+using cnf_solver_t = solver::exhaustive_solver<solver::uniform_constraint_state<bool_domain_t, std::uint8_t>>;
+
+template<typename solver_t> std::vector<std::vector<int>> cnf_solutions(solver_t &cnf_solver)
+{
+    std::vector<std::vector<int>> solutions;
+    cnf_solver.for_each_solution([&] {
+        std::vector<int> solution;
+        for (unsigned i = 0; i != cnf_solver.num_variables(); ++i) {
+            solution.push_back(cnf_solver.get_value(i) ? static_cast<int>(i + 1) : -static_cast<int>(i + 1));
+        }
+        solutions.push_back(solution);
+        return true;
+    });
+    return solutions;
+}
+}// namespace
+
+TEST_CASE("enumerate cnf", "[exhaustive_solver]")
+{
+    cnf_solver_t cnf_solver(3, { false, true });
+    cnf_solver.add_clause({ 1, 3 });
+    cnf_solver.add_clause({ -1, -3 });
+    CHECK(cnf_solutions(cnf_solver)
+          == std::vector<std::vector<int>>{ { -1, -2, 3 }, { -1, 2, 3 }, { 1, -2, -3 }, { 1, 2, -3 } });
+    CHECK(cnf_solver.count_solutions() == solver::model_count(4));
+    REQUIRE(cnf_solver.solve());
+    CHECK(!cnf_solver.get_value(0));
+    CHECK(!cnf_solver.get_value(1));
+    CHECK(cnf_solver.get_value(2));
+}
+
+TEST_CASE("stop enumeration", "[exhaustive_solver]")
+{
+    cnf_solver_t cnf_solver(4, { false, true });
+    unsigned calls = 0;
+    CHECK(cnf_solver.for_each_solution([&calls] { return ++calls != 3; }) == 3);
+}
+
+TEMPLATE_TEST_CASE("search again after stopping at a solution",
+    "[exhaustive_solver]",
+    cnf_solver_t,
+    solver::exhaustive_solver<solver::literal_state<std::uint8_t>>)
+{
+    TestType cnf_solver(3, { false, true });
+    cnf_solver.add_clause({ 1, 3 });
+    REQUIRE(cnf_solver.solve());
+    CHECK(cnf_solver.count_solutions() == solver::model_count(6));
+
+    REQUIRE(cnf_solver.solve());
+    unsigned calls = 0;
+    CHECK(cnf_solver.for_each_solution([&calls] { return ++calls != 2; }) == 2);
+    CHECK(cnf_solutions(cnf_solver).size() == 6);
+
+    REQUIRE(cnf_solver.solve());
+    cnf_solver.set_domain(1, { true });
+    CHECK(cnf_solver.count_solutions() == solver::model_count(3));
+}
+
+TEST_CASE("restrict a domain after stopping at a solution on a trail", "[exhaustive_solver]")
+{
+    using domain_t = solver::bitset_domain<64>;
+    using state_t = solver::trail_constraint_state<domain_t, std::uint8_t>;
+    solver::exhaustive_solver<state_t, solver::fd_constraint<state_t>> fd_solver(2, domain_t::range(0, 3));
+    REQUIRE(fd_solver.solve());
+    fd_solver.set_domain(0, domain_t{ 2 });
+    CHECK(fd_solver.count_solutions() == solver::model_count(4));
+    REQUIRE(fd_solver.solve());
+    CHECK(fd_solver.get_value(0) == 2);
+}
+
+TEST_CASE("count unsat", "[exhaustive_solver]")
+{
+    cnf_solver_t cnf_solver(2, { false, true });
+    cnf_solver.add_clause({ 1 });
+    cnf_solver.add_clause({ -1 });
+    CHECK(cnf_solver.count_solutions().is_zero());
+    CHECK(cnf_solutions(cnf_solver).empty());
+}
+
+TEST_CASE("count free variables without enumerating", "[exhaustive_solver]")
+{
+    cnf_solver_t cnf_solver(200, { false, true });
+    cnf_solver.add_clause({ 1, 2 });
+    // 3 * 2^198
+    CHECK(cnf_solver.count_solutions().to_string() == "1205203533194242706656471569255871951891652245337094626476032");
+}
+
+TEMPLATE_TEST_CASE("truth table counting matches enumeration",
+    "[exhaustive_solver]",
+    cnf_solver_t,
+    solver::exhaustive_solver<solver::literal_state<std::uint8_t>>)
+{
+    // Constrained variables 1..9, with 9 below the table of the last 6, and free variables 10..11.
+    for (std::uint64_t seed = 0; seed != 20; ++seed) {
+        solver::random_source random(seed);
+        TestType cnf_solver(11, { false, true });
+        for (unsigned clause = 0; clause != 12; ++clause) {
+            std::vector<int> literals;
+            for (unsigned i = 0; i != 3; ++i) {
+                const int variable = static_cast<int>(random.below(9)) + 1;
+                literals.push_back(random.coin() ? variable : -variable);
+            }
+            cnf_solver.add_clause(literals);
+        }
+        cnf_solver.set_domain(static_cast<unsigned>(random.below(9)), { random.coin() });
+        const size_t solutions = cnf_solver.for_each_solution([] { return true; });
+        CHECK(cnf_solver.count_solutions() == solver::model_count(solutions));
+    }
+}
+
+TEST_CASE("enumerate and count finite domain", "[exhaustive_solver]")
+{
+    using domain_t = solver::bitset_domain<64>;
+    using state_t = solver::trail_constraint_state<domain_t, std::uint8_t>;
+    using solver_t = solver::exhaustive_solver<state_t, solver::fd_constraint<state_t>>;
+    solver_t fd_solver(4, domain_t::range(0, 3));
+    fd_solver.add_constraint(solver::all_different<state_t>(
+        { solver_t::to_parameter(0), solver_t::to_parameter(1), solver_t::to_parameter(2) }));
+    std::vector<std::vector<int>> solutions;
+    CHECK(fd_solver.for_each_solution([&] {
+        solutions.push_back({ fd_solver.get_value(0), fd_solver.get_value(1), fd_solver.get_value(2) });
+        return true;
+    }) == 24 * 4);
+    CHECK(solutions.front() == std::vector<int>{ 0, 1, 2 });
+    CHECK(solutions.back() == std::vector<int>{ 3, 2, 1 });
+    CHECK(fd_solver.count_solutions() == solver::model_count(24 * 4));
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+#include <vector>
+
+#include "../src/all_different.hpp"
+#include "../src/bitset_domain.hpp"
+#include "../src/exhaustive_solver.hpp"
+#include "../src/fd_constraint.hpp"
+#include "../src/linear_inequality.hpp"
+
+using solver::propagation_result_t;
+using domain_t = solver::bitset_domain<64>;
+using state_t = solver::uniform_constraint_state<domain_t, std::uint8_t>;
+using parameter_t = state_t::parameter_t;
+
+namespace {
+std::vector<parameter_t> parameters(unsigned count)
+{
+    std::vector<parameter_t> ret;
+    for (unsigned i = 0; i != count; ++i) { ret.push_back(parameter_t{ static_cast<std::uint8_t>(i) }); }
+    return ret;
+}
+}// namespace
+
+TEST_CASE("all_different is_satisfied", "[all_different]")
+{
+    state_t state(3, domain_t::range(0, 2));
+    solver::all_different<state_t> constraint(parameters(3));
+    state.set_value(parameter_t{ 0 }, 2);
+    state.set_value(parameter_t{ 1 }, 0);
+    state.set_value(parameter_t{ 2 }, 1);
+    CHECK(constraint.is_satisfied(state));
+    state.set_value(parameter_t{ 2 }, 2);
+    CHECK(!constraint.is_satisfied(state));
+}
+
+TEST_CASE("all_different propagate", "[all_different]")
+{
+    state_t state(3, domain_t::range(0, 2));
+    solver::all_different<state_t> constraint(parameters(3));
+    REQUIRE(constraint.propagate(state, 0) == propagation_result_t::CONSISTENT);
+    CHECK(state.get_domain(parameter_t{ 1 }) == domain_t::range(0, 2));
+
+    state.set_domain(parameter_t{ 2 }, domain_t{ 0, 1 });
+    state.set_value(parameter_t{ 1 }, 1);
+    REQUIRE(constraint.propagate(state, 1) == propagation_result_t::SAT);
+    CHECK(state.get_domain(parameter_t{ 0 }) == domain_t{ 2 });
+    CHECK(state.get_domain(parameter_t{ 2 }) == domain_t{ 0 });
+
+    state.set_value(parameter_t{ 0 }, 0);
+    REQUIRE(constraint.propagate(state, 0) == propagation_result_t::UNSAT);
+    REQUIRE_THROWS_AS(constraint.propagate(state, 3), std::out_of_range);
+}
+
+TEST_CASE("linear_inequality is_satisfied", "[linear_inequality]")
+{
+    state_t state(2, domain_t::range(0, 9));
+    solver::linear_inequality<state_t> constraint(parameters(2), { 2, -1 }, 3);
+    state.set_value(parameter_t{ 0 }, 4);
+    state.set_value(parameter_t{ 1 }, 5);
+    CHECK(constraint.is_satisfied(state));
+    state.set_value(parameter_t{ 1 }, 4);
+    CHECK(!constraint.is_satisfied(state));
+}
+
+TEST_CASE("linear_inequality propagate", "[linear_inequality]")
+{
+    state_t state(2, domain_t::range(0, 9));
+    // 2*x0 - x1 <= 3, with x1 <= 5, forces x0 <= 4
+    solver::linear_inequality<state_t> constraint(parameters(2), { 2, -1 }, 3);
+    state.set_domain(parameter_t{ 1 }, domain_t::range(0, 5));
+    REQUIRE(constraint.propagate(state, 0) == propagation_result_t::CONSISTENT);
+    CHECK(state.get_domain(parameter_t{ 0 }) == domain_t::range(0, 4));
+    CHECK(state.get_domain(parameter_t{ 1 }) == domain_t::range(0, 5));
+
+    state.set_value(parameter_t{ 0 }, 4);
+    REQUIRE(constraint.propagate(state, 0) == propagation_result_t::CONSISTENT);
+    CHECK(state.get_domain(parameter_t{ 1 }) == domain_t::range(5, 5));
+    REQUIRE(constraint.propagate(state, 1) == propagation_result_t::SAT);
+
+    state.set_domain(parameter_t{ 1 }, domain_t::range(0, 4));
+    REQUIRE(constraint.propagate(state, 1) == propagation_result_t::UNSAT);
+    REQUIRE_THROWS_AS(solver::linear_inequality<state_t>(parameters(2), { 1 }, 0), std::invalid_argument);
+}
+
+TEST_CASE("exhaustive finite-domain solve", "[fd_constraint]")
+{
+    using solver_t = solver::exhaustive_solver<state_t, solver::fd_constraint<state_t>>;
+    solver_t fd_solver(3, domain_t::range(0, 2));
+    fd_solver.add_constraint(solver::all_different<state_t>(parameters(3)));
+    // x0 + 1 <= x2
+    fd_solver.add_constraint(solver::linear_inequality<state_t>(
+        { solver_t::to_parameter(0), solver_t::to_parameter(2) }, { 1, -1 }, -1));
+    fd_solver.set_domain(1, domain_t{ 0 });
+    REQUIRE(fd_solver.solve());
+    CHECK(fd_solver.get_value(0) == 1);
+    CHECK(fd_solver.get_value(1) == 0);
+    CHECK(fd_solver.get_value(2) == 2);
+
+    solver_t unsat_solver(4, domain_t::range(0, 2));
+    unsat_solver.add_constraint(solver::all_different<state_t>(parameters(4)));
+    CHECK(!unsat_solver.solve());
+}
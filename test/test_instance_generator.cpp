@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/boolean_domain.hpp"
+#include "../src/dimacs_parser.hpp"
+#include "../src/exhaustive_solver.hpp"
+#include "../src/instance_generator.hpp"
+#include "../src/literal_state.hpp"
+#include "../src/local_search.hpp"
+
+namespace {
+struct parsed_instance
+{
+    explicit parsed_instance(const std::string &text)
+    {
+        std::istringstream text_stream{ text };
+        solver::parse_dimacs(
+            text_stream,
+            [this](unsigned read_variables, unsigned read_clauses) {
+                variables = read_variables;
+                declared_clauses = read_clauses;
+            },
+            [this](const std::vector<int> &clause) { clauses.push_back(clause); });
+    }
+    bool is_satisfiable() const
+    {
+        solver::exhaustive_solver<solver::literal_state<std::uint8_t>> cnf_solver(variables, { false, true });
+        for (const std::vector<int> &clause : clauses) { cnf_solver.add_clause(clause); }
+        return cnf_solver.solve();
+    }
+    // Finds a model of satisfiable instances that are too large to search exhaustively.
+    bool has_model_by_local_search() const
+    {
+        solver::local_search_solver search(variables);
+        for (const std::vector<int> &clause : clauses) { search.add_clause(clause); }
+        return search.solve(1'000'000) == solver::local_search_result::satisfiable;
+    }
+    unsigned variables = 0;
+    unsigned declared_clauses = 0;
+    std::vector<std::vector<int>> clauses;
+};
+
+template<typename generator_t> std::string generate(generator_t generator)
+{
+    std::ostringstream out;
+    generator(out);
+    return out.str();
+}
+}// namespace
+
+TEST_CASE("random_source is deterministic", "[instance_generator]")
+{
+    solver::random_source first(42);
+    solver::random_source second(42);
+    for (unsigned i = 0; i != 100; ++i) { REQUIRE(first.next() == second.next()); }
+    for (unsigned i = 0; i != 1000; ++i) { REQUIRE(first.below(7) < 7); }
+}
+
+TEST_CASE("random ksat", "[instance_generator]")
+{
+    auto ksat = [](std::uint64_t seed) {
+        return generate([seed](std::ostream &out) { solver::generate_random_ksat(out, 20, 85, 3, seed); });
+    };
+    const std::string text = ksat(7);
+    CHECK(text == ksat(7));
+    CHECK(text != ksat(8));
+    const parsed_instance instance(text);
+    CHECK(instance.variables == 20);
+    CHECK(instance.declared_clauses == 85);
+    REQUIRE(instance.clauses.size() == 85);
+    for (const std::vector<int> &clause : instance.clauses) {
+        REQUIRE(clause.size() == 3);
+        REQUIRE(std::set<int>{ std::abs(clause[0]), std::abs(clause[1]), std::abs(clause[2]) }.size() == 3);
+    }
+    REQUIRE_THROWS_AS(generate([](std::ostream &out) { solver::generate_random_ksat(out, 2, 1, 3, 0); }),
+        std::invalid_argument);
+}
+
+TEST_CASE("pigeonhole", "[instance_generator]")
+{
+    const parsed_instance instance(generate([](std::ostream &out) { solver::generate_pigeonhole(out, 3); }));
+    CHECK(instance.variables == 12);
+    CHECK(instance.declared_clauses == 4 + 3 * 6);
+    CHECK(instance.clauses.size() == instance.declared_clauses);
+    CHECK(instance.clauses.front() == std::vector<int>{ 1, 2, 3 });
+    CHECK(!instance.is_satisfiable());
+}
+
+TEST_CASE("graph coloring", "[instance_generator]")
+{
+    auto coloring = [](unsigned colors) {
+        return parsed_instance(
+            generate([colors](std::ostream &out) { solver::generate_graph_coloring(out, 4, 12, colors, 3); }));
+    };
+    const parsed_instance instance = coloring(4);
+    CHECK(instance.variables == 16);
+    CHECK(instance.declared_clauses == 4 * (1 + 6) + 12 * 4);
+    CHECK(instance.clauses.size() == instance.declared_clauses);
+    CHECK(instance.is_satisfiable());
+    CHECK(!coloring(1).is_satisfiable());
+}
+
+TEST_CASE("parity", "[instance_generator]")
+{
+    for (unsigned length = 1; length != 5; ++length) {
+        const parsed_instance instance(
+            generate([length](std::ostream &out) { solver::generate_parity(out, 6, 8, length, 5); }));
+        CHECK(instance.variables == 6 + 8 * (length >= 2 ? length - 2 : 0));
+        CHECK(instance.clauses.size() == instance.declared_clauses);
+        CHECK(instance.has_model_by_local_search());
+    }
+}
+
+TEST_CASE("large instances stream through the buffer", "[instance_generator]")
+{
+    const parsed_instance instance(
+        generate([](std::ostream &out) { solver::generate_random_ksat(out, 100000, 20000, 5, 1); }));
+    CHECK(instance.clauses.size() == 20000);
+    CHECK(instance.variables == 100000);
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "../src/aligned_allocator.hpp"
+#include "../src/boolean_domain.hpp"
+#include "../src/exhaustive_solver.hpp"
+#include "../src/literal_state.hpp"
+
+using solver::boolean_domain;
+using state_t = solver::literal_state<std::uint8_t>;
+using parameter_t = state_t::parameter_t;
+
+TEST_CASE("boolean_domain", "[literal_state]")
+{
+    boolean_domain domain{ true, false };
+    CHECK(domain.size() == 2);
+    CHECK(std::vector<bool>(domain.begin(), domain.end()) == std::vector<bool>{ false, true });
+    CHECK(domain.erase(false) == 1);
+    CHECK(std::vector<bool>(domain.begin(), domain.end()) == std::vector<bool>{ true });
+    CHECK(domain.erase(true) == 1);
+    CHECK(domain.empty());
+    CHECK(domain.begin() == domain.end());
+}
+
+TEST_CASE("literal values", "[literal_state]")
+{
+    state_t state(3, { false, true });
+    const auto positive = state_t::make_literal(parameter_t{ 1 }, true);
+    const auto negative = state_t::make_literal(parameter_t{ 1 }, false);
+    CHECK(!state.is_true(positive));
+    CHECK(!state.is_false(negative));
+    CHECK(state.literal_mask(positive) == boolean_domain::full_mask);
+
+    state.set_value(parameter_t{ 1 }, false, 7);
+    CHECK(state.is_false(positive));
+    CHECK(state.is_true(negative));
+    CHECK(!state.get_value(parameter_t{ 1 }));
+    CHECK(state.reason(parameter_t{ 1 }) == 7);
+
+    state.set_domain(parameter_t{ 1 }, boolean_domain{});
+    CHECK(state.literal_mask(positive) == 0);
+    CHECK(state.literal_mask(negative) == 0);
+}
+
+TEST_CASE("literal_state backtrack", "[literal_state]")
+{
+    state_t state(3, { false, true });
+    state.new_level();
+    state.set_value(parameter_t{ 0 }, true);
+    state.new_level();
+    state.set_value(parameter_t{ 2 }, false, 1);
+    CHECK(state.level_of(parameter_t{ 0 }) == 1);
+    CHECK(state.level_of(parameter_t{ 2 }) == 2);
+    CHECK(state.trail_size() == 2);
+
+    state.backtrack();
+    CHECK(state.get_domain(parameter_t{ 2 }) == boolean_domain{ false, true });
+    CHECK(!state.saved_phase(parameter_t{ 2 }));
+    CHECK(state.get_value(parameter_t{ 0 }));
+
+    state.backtrack();
+    CHECK(state.get_domain(parameter_t{ 0 }) == boolean_domain{ false, true });
+    CHECK(state.saved_phase(parameter_t{ 0 }));
+    CHECK(state.trail_size() == 0);
+    state.bump_activity(parameter_t{ 0 }, 1.5);
+    CHECK(state.activity(parameter_t{ 0 }) == Approx(1.5));
+}
+
+TEST_CASE("aligned_allocator", "[literal_state]")
+{
+    const std::vector<std::uint8_t, solver::aligned_allocator<std::uint8_t>> line_aligned(100);
+    CHECK(reinterpret_cast<std::uintptr_t>(line_aligned.data()) % solver::cache_line_size == 0);
+    const std::vector<std::uint8_t, solver::aligned_allocator<std::uint8_t, solver::huge_page_size>> page_aligned(100);
+    CHECK(reinterpret_cast<std::uintptr_t>(page_aligned.data()) % solver::huge_page_size == 0);
+
+    solver::literal_state<std::uint16_t, true> state(1000, { false, true });
+    state.set_value({ 999 }, true);
+    CHECK(state.get_value({ 999 }));
+}
+
+TEST_CASE("exhaustive solve over literal_state", "[literal_state]")
+{
+    solver::exhaustive_solver<state_t> cnf_solver(3, { false, true });
+    cnf_solver.add_clause({ 1, 2 });
+    cnf_solver.add_clause({ -1, -2 });
+    cnf_solver.add_clause({ 2, 3 });
+    cnf_solver.add_clause({ -3 });
+    REQUIRE(cnf_solver.solve());
+    CHECK(!cnf_solver.get_value(0));
+    CHECK(cnf_solver.get_value(1));
+    CHECK(!cnf_solver.get_value(2));
+    CHECK(cnf_solver.count_solutions() == solver::model_count(1));
+    CHECK(cnf_solver.for_each_solution([] { return true; }) == 1);
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/dimacs_parser.hpp"
+#include "../src/instance_generator.hpp"
+#include "../src/local_search.hpp"
+
+namespace {
+struct cnf
+{
+    unsigned variables = 0;
+    std::vector<std::vector<int>> clauses;
+};
+
+template<typename generator_t> cnf generate(generator_t generator)
+{
+    std::stringstream text;
+    generator(text);
+    cnf result;
+    solver::parse_dimacs(
+        text,
+        [&result](unsigned variables, unsigned clauses) {
+            result.variables = variables;
+            result.clauses.reserve(clauses);
+        },
+        [&result](const std::vector<int> &clause) { result.clauses.push_back(clause); });
+    return result;
+}
+
+solver::local_search_solver make_solver(const cnf &formula, std::uint64_t seed)
+{
+    solver::local_search_solver search(formula.variables, seed);
+    for (const std::vector<int> &clause : formula.clauses) { search.add_clause(clause); }
+    return search;
+}
+
+bool is_true(const solver::local_search_solver &search, int literal)
+{
+    return search.get_value(static_cast<unsigned>(std::abs(literal)) - 1) == (literal > 0);
+}
+
+unsigned true_literals(const solver::local_search_solver &search, const std::vector<int> &clause)
+{
+    unsigned count = 0;
+    for (const int literal : clause) { count += is_true(search, literal) ? 1U : 0U; }
+    return count;
+}
+}// namespace
+
+TEST_CASE("local search finds a model of random 3-SAT", "[local_search]")
+{
+    const cnf formula = generate([](std::ostream &out) { solver::generate_random_ksat(out, 200, 700, 3, 5); });
+    solver::local_search_solver search = make_solver(formula, 3);
+    REQUIRE(search.solve(1'000'000) == solver::local_search_result::satisfiable);
+    CHECK(search.num_unsatisfied() == 0);
+    for (const std::vector<int> &clause : formula.clauses) { REQUIRE(true_literals(search, clause) != 0); }
+}
+
+TEST_CASE("local search finds a model of random 5-SAT", "[local_search]")
+{
+    const cnf formula = generate([](std::ostream &out) { solver::generate_random_ksat(out, 60, 900, 5, 9); });
+    solver::local_search_solver search = make_solver(formula, 4);
+    REQUIRE(search.solve(1'000'000) == solver::local_search_result::satisfiable);
+    for (const std::vector<int> &clause : formula.clauses) { REQUIRE(true_literals(search, clause) != 0); }
+}
+
+TEST_CASE("local search is deterministic", "[local_search]")
+{
+    const cnf formula = generate([](std::ostream &out) { solver::generate_random_ksat(out, 100, 400, 3, 2); });
+    solver::local_search_solver first = make_solver(formula, 17);
+    solver::local_search_solver second = make_solver(formula, 17);
+    REQUIRE(first.solve(1'000'000) == solver::local_search_result::satisfiable);
+    REQUIRE(second.solve(1'000'000) == solver::local_search_result::satisfiable);
+    CHECK(first.flips() == second.flips());
+    for (unsigned i = 0; i != formula.variables; ++i) { REQUIRE(first.get_value(i) == second.get_value(i)); }
+}
+
+TEST_CASE("local search gives up on an unsatisfiable formula", "[local_search]")
+{
+    const cnf formula = generate([](std::ostream &out) { solver::generate_pigeonhole(out, 4); });
+    solver::local_search_solver search = make_solver(formula, 1);
+    CHECK(search.solve(5000) == solver::local_search_result::unknown);
+    CHECK(search.flips() == 5000);
+    REQUIRE(search.num_unsatisfied() != 0);
+
+    // The incrementally maintained scores must match a recount from scratch.
+    std::vector<unsigned> breaks(formula.variables, 0);
+    std::vector<unsigned> makes(formula.variables, 0);
+    size_t unsatisfied = 0;
+    for (const std::vector<int> &clause : formula.clauses) {
+        const unsigned count = true_literals(search, clause);
+        for (const int literal : clause) {
+            const unsigned variable = static_cast<unsigned>(std::abs(literal)) - 1;
+            if (count == 0) {
+                ++makes[variable];
+            } else if (count == 1 && is_true(search, literal)) {
+                ++breaks[variable];
+            }
+        }
+        unsatisfied += count == 0 ? 1U : 0U;
+    }
+    CHECK(search.num_unsatisfied() == unsatisfied);
+    for (unsigned i = 0; i != formula.variables; ++i) {
+        REQUIRE(search.break_count(i) == breaks[i]);
+        REQUIRE(search.make_count(i) == makes[i]);
+    }
+}
+
+TEST_CASE("local search clause normalization", "[local_search]")
+{
+    solver::local_search_solver search(2);
+    search.add_clause({ 1, -1 });
+    CHECK(search.num_clauses() == 0);
+    search.add_clause({ 2, 2, -1 });
+    CHECK(search.num_clauses() == 1);
+    REQUIRE(search.solve(100) == solver::local_search_result::satisfiable);
+    CHECK((search.get_value(1) || !search.get_value(0)));
+    REQUIRE_THROWS_AS(search.add_clause({ 3 }), std::out_of_range);
+
+    search.add_clause({});
+    CHECK(search.solve(100) == solver::local_search_result::unsatisfiable);
+    CHECK(search.flips() == 0);
+}
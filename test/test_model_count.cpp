@@ -0,0 +1,43 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+
+#include "../src/model_count.hpp"
+
+using solver::model_count;
+
+TEST_CASE("small counts", "[model_count]")
+{
+    model_count count;
+    CHECK(count.is_zero());
+    CHECK(count.to_string() == "0");
+    ++count;
+    CHECK(count == model_count(1));
+    count += model_count(41);
+    CHECK(count.to_string() == "42");
+    count *= 0;
+    CHECK(count.is_zero());
+}
+
+TEST_CASE("carry across limbs", "[model_count]")
+{
+    model_count count(0xffffffffU);
+    ++count;
+    CHECK(count == model_count(0x100000000U));
+    count += model_count(0xffffffffU);
+    CHECK(count.to_string() == "8589934591");
+    CHECK((model_count(UINT64_MAX) + model_count(1)).to_string() == "18446744073709551616");
+}
+
+TEST_CASE("beyond 128 bits", "[model_count]")
+{
+    model_count count(1);
+    for (unsigned i = 0; i != 100; ++i) { count *= 2; }
+    CHECK(count.to_string() == "1267650600228229401496703205376");
+    for (unsigned i = 0; i != 100; ++i) { count *= 1024; }
+    count += model_count(1'000'000'000U);
+    CHECK(count.to_string()
+          == "1358298529049385849277351428359266778603493846931744549748519669727813092754241848720539208320756059"
+             "2298578262953847383475038725543234929971155548342800628721885763499406390331782864144164680730766837"
+             "1605262231765127984357721299565533552860322030803807757597323201989850948840040691161230841478754371"
+             "83658467465148948790553744165376");
+}
@@ -0,0 +1,68 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../src/solver_dispatch.hpp"
+
+namespace {
+template<solver::specialization_set enabled> unsigned dispatched_index_bits(size_t variables)
+{
+    return solver::dispatch_index_type<enabled>(
+        variables, []<typename index_t>(std::type_identity<index_t>) { return unsigned{ sizeof(index_t) * 8 }; });
+}
+
+constexpr solver::specialization_set all_enabled{};
+constexpr solver::specialization_set only_wide{ false, false, false };
+constexpr solver::specialization_set no_index8{ false, true, true };
+}// namespace
+
+TEST_CASE("select the narrowest index that fits", "[solver_dispatch]")
+{
+    using solver::instance_profile;
+    using solver::select_specialization;
+    using solver::specialization;
+    CHECK(select_specialization(instance_profile{ 0 }, all_enabled) == specialization{ 8, false });
+    CHECK(select_specialization(instance_profile{ 256 }, all_enabled) == specialization{ 8, false });
+    CHECK(select_specialization(instance_profile{ 257 }, all_enabled) == specialization{ 16, false });
+    CHECK(select_specialization(instance_profile{ 65536 }, all_enabled) == specialization{ 16, false });
+    CHECK(select_specialization(instance_profile{ 65537 }, all_enabled) == specialization{ 32, false });
+    CHECK(select_specialization(instance_profile{ 10 }, no_index8) == specialization{ 16, false });
+    CHECK(select_specialization(instance_profile{ 10 }, only_wide) == specialization{ 32, false });
+}
+
+TEST_CASE("select huge pages for big instances", "[solver_dispatch]")
+{
+    const solver::instance_profile big{ solver::huge_page_min_variables };
+    CHECK(solver::select_specialization(big, all_enabled) == solver::specialization{ 32, true });
+    CHECK(solver::select_specialization(big, only_wide) == solver::specialization{ 32, false });
+    const solver::instance_profile smaller{ solver::huge_page_min_variables - 1 };
+    CHECK_FALSE(solver::select_specialization(smaller, all_enabled).huge_pages);
+}
+
+TEST_CASE("dispatch index type", "[solver_dispatch]")
+{
+    CHECK(dispatched_index_bits<all_enabled>(3) == 8);
+    CHECK(dispatched_index_bits<all_enabled>(300) == 16);
+    CHECK(dispatched_index_bits<all_enabled>(70000) == 32);
+    CHECK(dispatched_index_bits<no_index8>(3) == 16);
+    CHECK(dispatched_index_bits<only_wide>(3) == 32);
+}
+
+TEST_CASE("dispatch dimacs solver", "[solver_dispatch]")
+{
+    // 300 variables do not fit an 8-bit index. The clauses only constrain the last two of them, and the search
+    // is exhaustive, so they are satisfiable by the first assignment of the free variables.
+    const unsigned variables = 300;
+    const std::vector<std::vector<int>> clauses = { { -299, 300 }, { -300 } };
+    auto solve = [&]<typename solver_t>(std::type_identity<solver_t>) {
+        solver_t cnf_solver(variables, { false, true });
+        for (const std::vector<int> &clause : clauses) { cnf_solver.add_clause(clause); }
+        REQUIRE(cnf_solver.solve());
+        CHECK_FALSE(cnf_solver.get_value(298));
+        CHECK_FALSE(cnf_solver.get_value(299));
+        return sizeof(typename solver_t::param_index_t);
+    };
+    CHECK(solver::dispatch_dimacs_solver<all_enabled>(solver::instance_profile{ variables }, solve) == 2);
+    CHECK(solver::dispatch_dimacs_solver<only_wide>(solver::instance_profile{ variables }, solve) == 4);
+}
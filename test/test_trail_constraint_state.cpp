@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+#include <set>
+#include <vector>
+
+#include "../src/bitset_domain.hpp"
+#include "../src/exhaustive_solver.hpp"
+#include "../src/fd_constraint.hpp"
+#include "../src/trail_constraint_state.hpp"
+
+using domain_t = solver::bitset_domain<64>;
+using state_t = solver::trail_constraint_state<domain_t, std::uint8_t>;
+using parameter_t = state_t::parameter_t;
+
+TEST_CASE("backtrack restores all changes of a level", "[trail_constraint_state]")
+{
+    state_t state(3, domain_t::range(0, 9));
+    state.set_domain(parameter_t{ 2 }, domain_t::range(0, 4));
+    REQUIRE(state.trail_size() == 0);
+
+    state.new_level();
+    state.set_value(parameter_t{ 0 }, 3);
+    state.set_domain(parameter_t{ 1 }, domain_t::range(2, 5));
+    state.set_domain(parameter_t{ 1 }, domain_t::range(2, 3));
+    CHECK(state.level() == 1);
+
+    state.new_level();
+    state.set_value(parameter_t{ 1 }, 2);
+    state.set_value(parameter_t{ 2 }, 4);
+    CHECK(state.get_value(parameter_t{ 1 }) == 2);
+
+    state.backtrack();
+    CHECK(state.level() == 1);
+    CHECK(state.get_domain(parameter_t{ 1 }) == domain_t::range(2, 3));
+    CHECK(state.get_domain(parameter_t{ 2 }) == domain_t::range(0, 4));
+
+    state.backtrack();
+    CHECK(state.level() == 0);
+    CHECK(state.trail_size() == 0);
+    CHECK(state.get_domain(parameter_t{ 0 }) == domain_t::range(0, 9));
+    CHECK(state.get_domain(parameter_t{ 1 }) == domain_t::range(0, 9));
+    CHECK(state.get_domain(parameter_t{ 2 }) == domain_t::range(0, 4));
+}
+
+TEST_CASE("backtrack std::set domains", "[trail_constraint_state]")
+{
+    using set_state_t = solver::trail_constraint_state<std::set<bool>, std::uint8_t>;
+    set_state_t state(2, { false, true });
+    state.new_level();
+    state.set_value(set_state_t::parameter_t{ 1 }, true);
+    CHECK(state.get_value(set_state_t::parameter_t{ 1 }));
+    state.backtrack();
+    CHECK(state.get_domain(set_state_t::parameter_t{ 1 }) == std::set<bool>{ false, true });
+}
+
+TEST_CASE("trail records value deltas", "[trail_constraint_state]")
+{
+    using set_state_t = solver::trail_constraint_state<std::set<int>, std::uint8_t>;
+    const set_state_t::parameter_t param{ 0 };
+    set_state_t state(1, { 1, 2, 3, 4 });
+    state.new_level();
+    state.set_domain(param, { 2, 3, 5 });
+    CHECK(state.trail_size() == 3);
+    state.remove_value(param, 3);
+    state.remove_value(param, 7);
+    CHECK(state.trail_size() == 4);
+    CHECK(state.get_domain(param) == std::set<int>{ 2, 5 });
+
+    state.new_level();
+    state.set_value(param, 4);
+    CHECK(state.get_domain(param) == std::set<int>{ 4 });
+    state.backtrack();
+    CHECK(state.get_domain(param) == std::set<int>{ 2, 5 });
+    state.backtrack();
+    CHECK(state.trail_size() == 0);
+    CHECK(state.get_domain(param) == std::set<int>{ 1, 2, 3, 4 });
+}
+
+TEST_CASE("exhaustive solve with propagation", "[trail_constraint_state]")
+{
+    using solver_t = solver::exhaustive_solver<state_t, solver::fd_constraint<state_t>>;
+    auto parameters = [](std::initializer_list<std::size_t> indexes) {
+        std::vector<parameter_t> ret;
+        for (std::size_t index : indexes) { ret.push_back(solver_t::to_parameter(index)); }
+        return ret;
+    };
+    solver_t fd_solver(4, domain_t::range(0, 3));
+    fd_solver.add_constraint(solver::all_different<state_t>(parameters({ 0, 1, 2, 3 })));
+    // x0 >= x1 + x2 + 1, x3 <= 1
+    fd_solver.add_constraint(solver::linear_inequality<state_t>(parameters({ 0, 1, 2 }), { -1, 1, 1 }, -1));
+    fd_solver.add_constraint(solver::linear_inequality<state_t>(parameters({ 3 }), { 1 }, 1));
+    REQUIRE(fd_solver.solve());
+    CHECK(fd_solver.get_value(0) == 3);
+    CHECK(fd_solver.get_value(1) == 0);
+    CHECK(fd_solver.get_value(2) == 2);
+    CHECK(fd_solver.get_value(3) == 1);
+
+    solver_t unsat_solver(6, domain_t::range(0, 4));
+    unsat_solver.add_constraint(solver::all_different<state_t>(parameters({ 0, 1, 2, 3, 4, 5 })));
+    CHECK(!unsat_solver.solve());
+}
@@ -6,6 +6,7 @@
 
 #include "../src/binary_clause.hpp"
 #include "../src/dimacs_parser.hpp"
+#include "../src/fd_parser.hpp"
 #include "test_constraints.hpp"
 
 using namespace solver::test;
@@ -119,4 +120,125 @@ TEST_CASE("dimacs parse", "[dimacs_parser]")
     CHECK(parse_result.n_clauses == 5);
     CHECK(parse_result.clauses
           == std::vector<std::vector<int>>{ { 1, -2, 3 }, { 2, 3 }, { -1, 2, -3, 4 }, { 1, -2, -3, -4 } });
-}
\ No newline at end of file
+}
+
+struct fd_parse_case
+{
+    explicit fd_parse_case(const std::string &text)
+    {
+        std::istringstream text_stream{ text };
+        auto construct_problem = [this](unsigned read_vars, unsigned read_values) {
+            this->n_variables = read_vars;
+            this->n_values = read_values;
+        };
+        auto restrict_domain = [this](unsigned variable, unsigned min_value, unsigned max_value) {
+            domains.push_back({ variable, min_value, max_value });
+        };
+        auto register_all_different = [this](const std::vector<unsigned> &variables) {
+            all_different.push_back(variables);
+        };
+        auto register_linear = [this](const std::vector<solver::linear_term> &terms, std::int64_t bound) {
+            std::vector<int> flat;
+            for (const solver::linear_term &term : terms) {
+                flat.push_back(term.coefficient);
+                flat.push_back(static_cast<int>(term.variable));
+            }
+            flat.push_back(static_cast<int>(bound));
+            linear.push_back(flat);
+        };
+
+        solver::parse_fd(text_stream, construct_problem, restrict_domain, register_all_different, register_linear);
+    }
+    std::vector<std::array<unsigned, 3>> domains;
+    std::vector<std::vector<unsigned>> all_different;
+    std::vector<std::vector<int>> linear;
+    unsigned n_variables = 0;
+    unsigned n_values = 0;
+};
+
+TEST_CASE("fd empty input", "[fd_parser]")
+{
+    REQUIRE_THROWS_MATCHES(fd_parse_case("c nothing"),
+        std::runtime_error,
+        Catch::Matchers::Message("Invalid fd input format - all lines are either empty or commented out"));
+}
+
+TEST_CASE("fd bad header", "[fd_parser]")
+{
+    REQUIRE_THROWS_MATCHES(fd_parse_case("p cnf 2 3"),
+        std::runtime_error,
+        Catch::Matchers::Message("1: Invalid fd input format, expecting a line prefix 'p fd ' but got 'p cnf 2 3'"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case("p fd 2 0"),
+        std::runtime_error,
+        Catch::Matchers::Message("1: Invalid fd input format, expecting a header 'p fd <variables: unsigned int> "
+                                 "<values: positive int>' but got 'p fd 2 0'"));
+}
+
+TEST_CASE("fd bad domain", "[fd_parser]")
+{
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            d 1 2 3)"),
+        std::runtime_error,
+        Catch::Matchers::Message(
+            "2: Expecting a domain 'd <variable> <min> <max>' with 0 <= min <= max < 3 but got 'd 1 2 3'"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            d 3 0 1)"),
+        std::runtime_error,
+        Catch::Matchers::Message("2: Expecting a variable in the range 1..2 in the line 'd 3 0 1'"));
+}
+
+TEST_CASE("fd bad constraints", "[fd_parser]")
+{
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            alldiff 1 2)"),
+        std::runtime_error,
+        Catch::Matchers::Message("2: Missing 0 at the end of the line for line 'alldiff 1 2'"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            linear 1 x <= 2)"),
+        std::runtime_error,
+        Catch::Matchers::Message("2: Expecting a variable in the range 1..2 in the line 'linear 1 x <= 2'"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            linear 1 1 2 <= 2)"),
+        std::runtime_error,
+        Catch::Matchers::Message("2: Expecting a variable in the range 1..2 in the line 'linear 1 1 2 <= 2'"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            linear 1 1 <)"),
+        std::runtime_error,
+        Catch::Matchers::Message("2: Invalid coefficient '<' in the line 'linear 1 1 <'"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            linear -2147483648 1 >= 0)"),
+        std::runtime_error,
+        Catch::Matchers::Message(
+            "2: Coefficient '-2147483648' is out of range in the line 'linear -2147483648 1 >= 0'"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            linear 1 1 = -9223372036854775808)"),
+        std::runtime_error,
+        Catch::Matchers::Message(
+            "2: Bound -9223372036854775808 is out of range in the line 'linear 1 1 = -9223372036854775808'"));
+    CHECK_NOTHROW(fd_parse_case(R"(p fd 2 3
+                                   linear -2147483647 1 >= -9223372036854775807)"));
+    REQUIRE_THROWS_MATCHES(fd_parse_case(R"(p fd 2 3
+                                            atmost 1 2 0)"),
+        std::runtime_error,
+        Catch::Matchers::Message("2: Unknown constraint 'atmost' in the line 'atmost 1 2 0'"));
+}
+
+TEST_CASE("fd parse", "[fd_parser]")
+{
+    fd_parse_case parse_result = fd_parse_case(R"(
+        c comment
+        p fd 3 10
+        d 2 1 5
+        alldiff 1 2 3 0
+        linear 2 1 -1 3 <= 4
+        linear 1 2 >= 3
+        linear 1 1 1 2 = 7
+    )");
+    CHECK(parse_result.n_variables == 3);
+    CHECK(parse_result.n_values == 10);
+    CHECK(parse_result.domains == std::vector<std::array<unsigned, 3>>{ { 1, 1, 5 } });
+    CHECK(parse_result.all_different == std::vector<std::vector<unsigned>>{ { 0, 1, 2 } });
+    CHECK(parse_result.linear
+          == std::vector<std::vector<int>>{
+              { 2, 0, -1, 2, 4 }, { -1, 1, -3 }, { 1, 0, 1, 1, 7 }, { -1, 0, -1, 1, -7 } });
+}